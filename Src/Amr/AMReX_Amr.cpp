@@ -44,6 +44,7 @@
 #include <iomanip>
 #include <limits>
 #include <list>
+#include <set>
 #include <sstream>
 
 namespace amrex {
@@ -90,6 +91,10 @@ namespace
     bool prereadFAHeaders;
     VisMF::Header::Version plot_headerversion(VisMF::Header::Version_v1);
     VisMF::Header::Version checkpoint_headerversion(VisMF::Header::Version_v1);
+    bool checkpoint_incremental;
+    int  checkpoint_full_int;
+    std::string incremental_checkpoint_file;   // ---- the checkpoint unchanged data refer to
+    int  ncheckpoints_since_full;
 }
 
 
@@ -127,6 +132,9 @@ Amr::Initialize ()
     prereadFAHeaders         = true;
     plot_headerversion       = VisMF::Header::Version_v1;
     checkpoint_headerversion = VisMF::Header::Version_v1;
+    checkpoint_incremental   = false;
+    checkpoint_full_int      = 10;
+    ncheckpoints_since_full  = 0;
 #if defined(AMREX_USE_SENSEI_INSITU) && !defined(AMREX_NO_SENSEI_AMR_INST)
     insitu_bridge            = nullptr;
 #endif
@@ -499,6 +507,11 @@ Amr::InitAmr ()
 
     loadbalance_max_fac = 1.5;
     pp.queryAdd("loadbalance_max_fac", loadbalance_max_fac);
+
+    // If positive and the grids have not changed, rebalance by migrating as
+    // few boxes as possible until this efficiency is reached.
+    loadbalance_efficiency = 0.0;
+    pp.queryAdd("loadbalance_efficiency", loadbalance_efficiency);
 }
 
 int
@@ -1417,6 +1430,20 @@ Amr::restart (const std::string& filename)
         runlog << "RESTART from file = " << filename << '\n';
     }
 
+    // ---- an incremental checkpoint cannot be read without the ones it refers to
+    if (ParallelDescriptor::IOProcessor()) {
+        std::ifstream refFile(filename + "/CheckPointReferences.txt");
+        std::string refDir;
+        while (refFile >> refDir) {
+            if ( ! amrex::FileExists(filename + '/' + refDir + "/Header")) {
+                amrex::Abort("Amr::restart: the incremental checkpoint " + filename
+                             + " refers to the data of " + refDir + " (relative to it),"
+                             + " which is missing.  Restore it or restart from a"
+                             + " checkpoint written in full.");
+            }
+        }
+    }
+
     // ---- preread and broadcast all FabArray headers if this file exists
     std::map<std::string, Vector<char> > faHeaderMap;
     if(prereadFAHeaders) {
@@ -1739,10 +1766,30 @@ Amr::checkPoint ()
   // For AsyncOut, we need to turn off stream retry and write to ckfile directly.
   const std::string ckfileTemp = (AsyncOut::UseAsyncOut()) ? ckfile : (ckfile + ".temp");
 
+  //
+  // An incremental checkpoint refers to the previous one for the unchanged data.
+  // A checkpoint of the same name would be moved out of the way below.
+  //
+  std::string prevCkfile;
+  if (checkpoint_incremental && ! AsyncOut::UseAsyncOut() && incremental_checkpoint_file != ckfile &&
+      (checkpoint_full_int <= 0 || ncheckpoints_since_full < checkpoint_full_int))
+  {
+      prevCkfile = incremental_checkpoint_file;
+  }
+  bool firstTry(true);
+
   while(sretry.TryFileOutput()) {
 
     StateData::ClearFabArrayHeaderNames();
 
+    // ---- a retry writes everything, the previous try may have been recorded
+    StateData::SetIncrementalCheckPoint(checkpoint_incremental,
+                                        firstTry ? prevCkfile : std::string());
+    if( ! firstTry) {
+        prevCkfile.clear();
+    }
+    firstTry = false;
+
     //
     //  if either the ckfile or ckfileTemp exists, rename them
     //  to move them out of the way.  then create ckfile
@@ -1841,6 +1888,22 @@ Amr::checkPoint ()
         }
     }
 
+    if (ParallelDescriptor::IOProcessor()) {
+        const std::set<std::string> &refDirs = StateData::ReferencedCheckPoints();
+        if( ! refDirs.empty()) {
+            std::string refFileName = ckfileTemp + "/CheckPointReferences.txt";
+            std::ofstream refFile(refFileName.c_str(),
+                                  std::ios::out | std::ios::trunc | std::ios::binary);
+            if ( ! refFile.good()) {
+                amrex::FileOpenFailed(refFileName);
+            }
+
+            for(const std::string &refDir : refDirs) {
+                refFile << refDir << '\n';
+            }
+        }
+    }
+
     if(ParallelDescriptor::IOProcessor()) {
         HeaderFile.precision(old_prec);
 
@@ -1873,6 +1936,12 @@ Amr::checkPoint ()
     }
   }  // end while
 
+  StateData::SetIncrementalCheckPoint(false);
+  if (checkpoint_incremental) {
+      incremental_checkpoint_file = ckfile;
+      ncheckpoints_since_full = prevCkfile.empty() ? 1 : ncheckpoints_since_full + 1;
+  }
+
   //
   // Restore the previous FAB format.
   //
@@ -2748,10 +2817,31 @@ Amr::makeLoadBalanceDistributionMap (int lev, Real time, const BoxArray& ba) con
         MultiFab workest(ba, dmtmp, 1, 0, MFInfo(), FArrayBoxFactory());
         AmrLevel::FillPatch(*amr_level[lev], workest, 0, time, work_est_type, 0, 1, 0);
 
-        Real navg = static_cast<Real>(ba.size()) / static_cast<Real>(ParallelDescriptor::NProcs());
-        int nmax = static_cast<int>(std::max(std::round(loadbalance_max_fac*navg), std::ceil(navg)));
+        if (loadbalance_efficiency > 0.0 && ba == boxArray(lev))
+        {
+            const DescriptorList& desc_lst = AmrLevel::get_desc_lst();
+            Long ncomp = 0;
+            for (int i = 0; i < desc_lst.size(); ++i) {
+                ncomp += desc_lst[i].nComp();
+            }
 
-        newdm = DistributionMapping::makeKnapSack(workest, nmax);
+            Real current_eff, proposed_eff;
+            Long moved_bytes;
+            newdm = DistributionMapping::makeRebalance(workest, ncomp*sizeof(Real),
+                                                       loadbalance_efficiency,
+                                                       current_eff, proposed_eff, moved_bytes);
+            if (verbose) {
+                amrex::Print() << "Rebalance efficiency: " << current_eff << " -> "
+                               << proposed_eff << ", moving " << moved_bytes << " bytes\n";
+            }
+        }
+        else
+        {
+            Real navg = static_cast<Real>(ba.size()) / static_cast<Real>(ParallelDescriptor::NProcs());
+            int nmax = static_cast<int>(std::max(std::round(loadbalance_max_fac*navg), std::ceil(navg)));
+
+            newdm = DistributionMapping::makeKnapSack(workest, nmax);
+        }
     }
     else
     {
@@ -3262,6 +3352,16 @@ Amr::initPltAndChk ()
     if(chvInt != checkpoint_headerversion) {
       checkpoint_headerversion = static_cast<VisMF::Header::Version> (chvInt);
     }
+
+    //
+    // With incremental checkpoints, only the FABs that changed since the
+    // previous checkpoint are written.  Every checkpoint_full_int-th
+    // checkpoint is written in full (0 ==> only the first one).  The
+    // earlier checkpoints a checkpoint refers to are listed in its
+    // CheckPointReferences.txt and must be kept for a restart from it.
+    //
+    pp.queryAdd("checkpoint_incremental", checkpoint_incremental);
+    pp.queryAdd("checkpoint_full_int", checkpoint_full_int);
 }
 
 
@@ -26,6 +26,9 @@ static constexpr int MFOLDDATA = 1;
 
 Vector<std::string> StateData::fabArrayHeaderNames;
 std::map<std::string, Vector<char> > *StateData::faHeaderMap;
+bool StateData::incrementalCheckPoint(false);
+std::string StateData::prevCheckPointFile;
+std::set<std::string> StateData::referencedCheckPoints;
 
 
 StateData::StateData ()
@@ -57,7 +60,9 @@ StateData::StateData (StateData&& rhs) noexcept
       old_time(rhs.old_time),
       new_data(std::move(rhs.new_data)),
       old_data(std::move(rhs.old_data)),
-      arena(rhs.arena)
+      arena(rhs.arena),
+      new_chk_info(std::move(rhs.new_chk_info)),
+      old_chk_info(std::move(rhs.old_chk_info))
 {
 }
 
@@ -821,10 +826,36 @@ StateData::checkPoint (const std::string& name,
 
     if (desc->store_in_checkpoint())
     {
+        //
+        // The name of this StateData in the previous checkpoint.
+        //
+        std::string prev_name;
+        if ( ! prevCheckPointFile.empty()) {
+            prev_name = prevCheckPointFile + '/' + name;
+        }
+
+        //
+        // Only keep what was written to the previous checkpoint.
+        //
+        if ( ! incrementalCheckPoint || AsyncOut::UseAsyncOut()) {
+            new_chk_info.clear();
+            old_chk_info.clear();
+        } else if ( ! dump_old) {
+            old_chk_info.clear();
+        }
+
         BL_ASSERT(new_data);
         std::string mf_fullpath_new(fullpathname + NewSuffix);
         if (AsyncOut::UseAsyncOut()) {
             VisMF::AsyncWrite(*new_data,mf_fullpath_new);
+        } else if (incrementalCheckPoint) {
+            VisMF::WriteIncremental(*new_data, mf_fullpath_new,
+                                    prev_name.empty() ? prev_name : prev_name + NewSuffix,
+                                    new_chk_info, how);
+            if (ParallelDescriptor::IOProcessor()) {
+                VisMF::ReferencedDirectories(new_chk_info, name + NewSuffix,
+                                             referencedCheckPoints);
+            }
         } else {
             VisMF::Write(*new_data,mf_fullpath_new,how);
         }
@@ -835,6 +866,14 @@ StateData::checkPoint (const std::string& name,
             std::string mf_fullpath_old(fullpathname + OldSuffix);
             if (AsyncOut::UseAsyncOut()) {
                 VisMF::AsyncWrite(*old_data,mf_fullpath_old);
+            } else if (incrementalCheckPoint) {
+                VisMF::WriteIncremental(*old_data, mf_fullpath_old,
+                                        prev_name.empty() ? prev_name : prev_name + OldSuffix,
+                                        old_chk_info, how);
+                if (ParallelDescriptor::IOProcessor()) {
+                    VisMF::ReferencedDirectories(old_chk_info, name + OldSuffix,
+                                                 referencedCheckPoints);
+                }
             } else {
                 VisMF::Write(*old_data,mf_fullpath_old,how);
             }
@@ -842,6 +881,14 @@ StateData::checkPoint (const std::string& name,
     }
 }
 
+void
+StateData::SetIncrementalCheckPoint (bool incremental, const std::string& prev_chkfile)
+{
+    incrementalCheckPoint = incremental;
+    prevCheckPointFile = prev_chkfile;
+    referencedCheckPoints.clear();
+}
+
 void
 StateData::printTimeInterval (std::ostream &os) const
 {
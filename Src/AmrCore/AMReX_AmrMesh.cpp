@@ -105,6 +105,7 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
 
     pp.queryAdd("n_proper",n_proper);
     pp.queryAdd("grid_eff",grid_eff);
+    pp.queryAdd("use_distributed_clustering",use_distributed_clustering);
     int cnt = pp.countval("n_error_buf");
     if (cnt > 0) {
         Vector<int> neb;
@@ -672,13 +673,23 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
         tags.setVal(p_n_comp_ba[levc],TagBox::CLEAR);
         p_n_comp_ba[levc].clear();
         //
-        // Create initial cluster containing all tagged points.
+        // Create initial cluster containing all tagged points.  In the
+        // distributed mode, each process only keeps its own tags.
         //
         Gpu::PinnedVector<IntVect> tagvec;
-        tags.collate(tagvec);
+        bool has_tags;
+        if (use_distributed_clustering) {
+            tags.local_collate(tagvec);
+            Long ntags = tagvec.size();
+            ParallelDescriptor::ReduceLongSum(ntags);
+            has_tags = ntags > 0;
+        } else {
+            tags.collate(tagvec);
+            has_tags = tagvec.size() > 0;
+        }
         tags.clear();
 
-        if (tagvec.size() > 0)
+        if (has_tags)
         {
             //
             // Created new level, now generate efficient grids.
@@ -689,7 +700,9 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
 
             if (levf > useFixedUpToLevel()) {
                 BoxList new_bx;
-                if (ParallelDescriptor::IOProcessor()) {
+                if ((use_distributed_clustering || ParallelDescriptor::IOProcessor())
+                    && tagvec.size() > 0)
+                {
                     BL_PROFILE("AmrMesh-cluster");
                     //
                     // Construct initial cluster.
@@ -714,7 +727,22 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
                         new_bx.intersect(Geom(levc).Domain());
                     }
                 }
-                new_bx.Bcast();  // Broadcast the new BoxList to other processes
+
+                if (use_distributed_clustering) {
+                    //
+                    // Every process gets the boxes of all processes.  Boxes
+                    // of neighboring processes may overlap because each
+                    // cluster is a bounding box of local tags only.  Each of
+                    // them is properly nested, so their union is too.
+                    //
+                    BL_PROFILE("AmrMesh-merge-clusters");
+                    Vector<Box> bxs(new_bx.begin(), new_bx.end());
+                    amrex::AllGatherBoxes(bxs);
+                    new_bx = amrex::removeOverlap(BoxList(std::move(bxs)));
+                    new_bx.simplify();
+                } else {
+                    new_bx.Bcast();  // Broadcast the new BoxList to other processes
+                }
 
                 //
                 // Refine up to levf.
@@ -1037,6 +1065,7 @@ std::ostream& operator<< (std::ostream& os, AmrMesh const& amr_mesh)
     os << "  refine_grid_layout_dims = " << amr_mesh.refine_grid_layout_dims << "\n";
     os << "  check_input = " << amr_mesh.check_input  << "\n";
     os << "  use_new_chop = " << amr_mesh.use_new_chop << "\n";
+    os << "  use_distributed_clustering = " << amr_mesh.use_distributed_clustering << "\n";
     os << "  iterate_on_new_grids = " << amr_mesh.iterate_on_new_grids << "\n";
     return os;
 }
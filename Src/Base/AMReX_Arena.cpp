@@ -3,6 +3,7 @@
 #include <AMReX_BArena.H>
 #include <AMReX_CArena.H>
 #include <AMReX_PArena.H>
+#include <AMReX_TArena.H>
 
 #include <AMReX.H>
 #include <AMReX_Print.H>
@@ -49,6 +50,9 @@ namespace {
     bool the_arena_is_managed = true;
 #endif
     bool abort_on_out_of_gpu_memory = false;
+    bool the_arena_use_thread_cache = false;
+    Long the_arena_thread_cache_max_block_size = TArena::DefaultMaxBlockSize;
+    Long the_arena_thread_cache_slab_size = TArena::DefaultSlabSize;
 }
 
 const std::size_t Arena::align_size;
@@ -271,7 +275,22 @@ Arena::Initialize ()
     pp.queryAdd(  "the_async_arena_release_threshold",   the_async_arena_release_threshold);
     pp.queryAdd("the_arena_is_managed", the_arena_is_managed);
     pp.queryAdd("abort_on_out_of_gpu_memory", abort_on_out_of_gpu_memory);
+    pp.queryAdd("the_arena_use_thread_cache", the_arena_use_thread_cache);
+    pp.queryAdd("the_arena_thread_cache_max_block_size", the_arena_thread_cache_max_block_size);
+    pp.queryAdd("the_arena_thread_cache_slab_size", the_arena_thread_cache_slab_size);
 
+#ifndef AMREX_USE_GPU
+    if (the_arena_use_thread_cache)
+    {
+        // The thread caches write a header in front of each block, so
+        // this is only available when The_Arena() is in host memory.
+        ArenaInfo ai{};
+        ai.SetReleaseThreshold(the_arena_release_threshold);
+        the_arena = new TArena(the_arena_thread_cache_max_block_size,
+                               the_arena_thread_cache_slab_size, 0, ai);
+    }
+    else
+#endif
     {
 #if defined(BL_COALESCE_FABS) || defined(AMREX_USE_GPU)
         ArenaInfo ai{};
@@ -376,6 +395,10 @@ Arena::PrintUsage ()
         if (p) {
             p->PrintUsage("The         Arena");
         }
+        TArena* tp = dynamic_cast<TArena*>(The_Arena());
+        if (tp) {
+            tp->PrintUsage("The         Arena");
+        }
     }
     if (The_Device_Arena() && The_Device_Arena() != The_Arena()) {
         CArena* p = dynamic_cast<CArena*>(The_Device_Arena());
@@ -421,6 +444,10 @@ Arena::PrintUsageToFiles (const std::string& filename, const std::string& messag
         if (p) {
             p->PrintUsage(ofs, "The         Arena", "    ");
         }
+        TArena* tp = dynamic_cast<TArena*>(The_Arena());
+        if (tp) {
+            tp->PrintUsage(ofs, "The         Arena", "    ");
+        }
     }
     if (The_Device_Arena() && The_Device_Arena() != The_Arena()) {
         CArena* p = dynamic_cast<CArena*>(The_Device_Arena());
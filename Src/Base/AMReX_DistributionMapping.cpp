@@ -9,6 +9,7 @@
 #include <AMReX_VisMF.H>
 #include <AMReX_Utility.H>
 #include <AMReX_Morton.H>
+#include <AMReX_Machine.H>
 
 #include <iostream>
 #include <fstream>
@@ -22,9 +23,13 @@
 #include <string>
 #include <cstring>
 #include <iomanip>
+#include <set>
 
 namespace {
 int flag_verbose_mapper;
+int graph_ngrow;
+int graph_node_aware;
+amrex::Real graph_imbalance;
 }
 
 namespace amrex {
@@ -74,6 +79,9 @@ DistributionMapping::strategy (DistributionMapping::Strategy how)
     case RRSFC:
         m_BuildMap = &DistributionMapping::RRSFCProcessorMap;
         break;
+    case GRAPH:
+        m_BuildMap = &DistributionMapping::GraphProcessorMap;
+        break;
     default:
         amrex::Error("Bad DistributionMapping::Strategy");
     }
@@ -115,6 +123,9 @@ DistributionMapping::Initialize ()
     max_efficiency   = 0.9_rt;
     node_size        = 0;
     flag_verbose_mapper = 0;
+    graph_ngrow      = 1;
+    graph_node_aware = 0;
+    graph_imbalance  = 0.05_rt;
 
     ParmParse pp("DistributionMapping");
 
@@ -124,6 +135,9 @@ DistributionMapping::Initialize ()
     pp.queryAdd("sfc_threshold",       sfc_threshold);
     pp.queryAdd("node_size",           node_size);
     pp.queryAdd("verbose_mapper",      flag_verbose_mapper);
+    pp.queryAdd("graph_ngrow",         graph_ngrow);
+    pp.queryAdd("graph_node_aware",    graph_node_aware);
+    pp.queryAdd("graph_imbalance",     graph_imbalance);
 
     std::string theStrategy;
 
@@ -145,6 +159,10 @@ DistributionMapping::Initialize ()
         {
             strategy(RRSFC);
         }
+        else if (theStrategy == "GRAPH")
+        {
+            strategy(GRAPH);
+        }
         else
         {
             std::string msg("Unknown strategy: ");
@@ -1397,6 +1415,642 @@ DistributionMapping::RRSFCProcessorMap (const BoxArray&          boxes,
     RRSFCDoIt(boxes,nprocs);
 }
 
+namespace {
+
+//
+// The box adjacency graph in compressed sparse row format.  Vertex i is box i
+// weighted by its cost, and the edge between boxes i and j is weighted by the
+// number of ghost cells they exchange.
+//
+struct BoxGraph
+{
+    std::vector<Long> vwgt;
+    std::vector<int>  xadj;
+    std::vector<int>  adjncy;
+    std::vector<Long> adjwgt;
+
+    int size () const noexcept { return static_cast<int>(vwgt.size()); }
+};
+
+BoxGraph
+makeBoxGraph (const BoxArray& ba, const std::vector<Long>& wgts, const IntVect& ngrow)
+{
+    const int N = ba.size();
+
+    std::vector<std::map<int,Long> > adj(N);
+    std::vector<std::pair<int,Box> > isects;
+
+    for (int i = 0; i < N; ++i)
+    {
+        ba.intersections(amrex::grow(ba[i],ngrow), isects);
+
+        for (const auto& is : isects)
+        {
+            if (is.first != i)
+            {
+                adj[i][is.first] += is.second.numPts();
+                adj[is.first][i] += is.second.numPts();
+            }
+        }
+    }
+
+    BoxGraph g;
+    g.vwgt = wgts;
+    g.xadj.resize(N+1, 0);
+    for (int i = 0; i < N; ++i) {
+        g.xadj[i+1] = g.xadj[i] + static_cast<int>(adj[i].size());
+    }
+    g.adjncy.reserve(g.xadj[N]);
+    g.adjwgt.reserve(g.xadj[N]);
+    for (int i = 0; i < N; ++i) {
+        for (const auto& kv : adj[i]) {
+            g.adjncy.push_back(kv.first);
+            g.adjwgt.push_back(kv.second);
+        }
+    }
+    return g;
+}
+
+//
+// The subgraph induced by the vertices u with where[u] == side.  Edges
+// leaving the subgraph are dropped.  gid maps the vertices of g to the
+// original boxes and is mapped to the subgraph in sub_gid.
+//
+BoxGraph
+subGraph (const BoxGraph& g, const std::vector<int>& where, int side,
+          const std::vector<int>& gid, std::vector<int>& sub_gid)
+{
+    const int n = g.size();
+    std::vector<int> lid(n, -1);
+    sub_gid.clear();
+    for (int u = 0; u < n; ++u) {
+        if (where[u] == side) {
+            lid[u] = static_cast<int>(sub_gid.size());
+            sub_gid.push_back(gid[u]);
+        }
+    }
+
+    BoxGraph sg;
+    sg.xadj.push_back(0);
+    for (int u = 0; u < n; ++u)
+    {
+        if (lid[u] < 0) continue;
+        sg.vwgt.push_back(g.vwgt[u]);
+        for (int e = g.xadj[u]; e < g.xadj[u+1]; ++e) {
+            const int v = g.adjncy[e];
+            if (lid[v] >= 0) {
+                sg.adjncy.push_back(lid[v]);
+                sg.adjwgt.push_back(g.adjwgt[e]);
+            }
+        }
+        sg.xadj.push_back(static_cast<int>(sg.adjncy.size()));
+    }
+    return sg;
+}
+
+//
+// Coarsens g by heavy edge matching: every vertex is paired with the unmatched
+// neighbor it shares the most ghost cells with, as long as the combined weight
+// stays below maxvwgt.  cmap is the coarse vertex of every vertex of g.
+//
+BoxGraph
+coarsenGraph (const BoxGraph& g, Long maxvwgt, std::vector<int>& cmap)
+{
+    const int n = g.size();
+
+    // Visit the vertices with few neighbors first so they still find a partner.
+    std::vector<int> perm(n);
+    std::iota(perm.begin(), perm.end(), 0);
+    std::stable_sort(perm.begin(), perm.end(), [&] (int a, int b) {
+        return g.xadj[a+1]-g.xadj[a] < g.xadj[b+1]-g.xadj[b];
+    });
+
+    std::vector<int> match(n, -1);
+    for (int u : perm)
+    {
+        if (match[u] >= 0) continue;
+        int best = u;
+        Long bestwgt = -1;
+        for (int e = g.xadj[u]; e < g.xadj[u+1]; ++e) {
+            const int v = g.adjncy[e];
+            if (match[v] < 0 && g.adjwgt[e] > bestwgt && g.vwgt[u]+g.vwgt[v] <= maxvwgt) {
+                best = v;
+                bestwgt = g.adjwgt[e];
+            }
+        }
+        match[u] = best;
+        match[best] = u;
+    }
+
+    cmap.assign(n, -1);
+    std::vector<int> rep;
+    for (int u = 0; u < n; ++u) {
+        if (cmap[u] < 0) {
+            cmap[u] = cmap[match[u]] = static_cast<int>(rep.size());
+            rep.push_back(u);
+        }
+    }
+    const int nc = static_cast<int>(rep.size());
+
+    BoxGraph cg;
+    cg.vwgt.assign(nc, 0);
+    cg.xadj.assign(nc+1, 0);
+    // Position of the coarse neighbor in the row being built
+    std::vector<int> pos(nc, -1);
+    for (int cu = 0; cu < nc; ++cu)
+    {
+        const int row = static_cast<int>(cg.adjncy.size());
+        const int us[2] = {rep[cu], match[rep[cu]]};
+        for (int k = 0, nu = (us[0] == us[1]) ? 1 : 2; k < nu; ++k)
+        {
+            const int u = us[k];
+            cg.vwgt[cu] += g.vwgt[u];
+            for (int e = g.xadj[u]; e < g.xadj[u+1]; ++e) {
+                const int cv = cmap[g.adjncy[e]];
+                if (cv == cu) continue;
+                if (pos[cv] < row) {
+                    pos[cv] = static_cast<int>(cg.adjncy.size());
+                    cg.adjncy.push_back(cv);
+                    cg.adjwgt.push_back(g.adjwgt[e]);
+                } else {
+                    cg.adjwgt[pos[cv]] += g.adjwgt[e];
+                }
+            }
+        }
+        cg.xadj[cu+1] = static_cast<int>(cg.adjncy.size());
+    }
+    return cg;
+}
+
+Long
+edgeCut (const BoxGraph& g, const std::vector<int>& where)
+{
+    Long cut = 0;
+    for (int u = 0, n = g.size(); u < n; ++u) {
+        for (int e = g.xadj[u]; e < g.xadj[u+1]; ++e) {
+            if (where[g.adjncy[e]] != where[u]) cut += g.adjwgt[e];
+        }
+    }
+    return cut/2;
+}
+
+//
+// Fiduccia-Mattheyses refinement of a bisection.  Each pass moves every
+// vertex at most once, picking the move with the largest reduction of the
+// edge cut that respects the weight limits of the two sides, and then rolls
+// back to the best state seen.  States are ranked by how far they exceed the
+// limits first and by edge cut second.
+//
+void
+refineBisection (const BoxGraph& g, std::vector<int>& where, const Long limit[2], int npasses)
+{
+    const int n = g.size();
+    if (n < 2) return;
+
+    Long pw[2] = {0, 0};
+    for (int u = 0; u < n; ++u) {
+        pw[where[u]] += g.vwgt[u];
+    }
+
+    auto overload = [&] () {
+        return std::max({pw[0]-limit[0], pw[1]-limit[1], Long(0)});
+    };
+
+    std::vector<Long> gain(n);
+    std::vector<char> locked(n);
+    std::vector<int> moves;
+
+    for (int pass = 0; pass < npasses; ++pass)
+    {
+        // Gain of moving u to the other side: external minus internal edges
+        Long cut = 0;
+        std::set<std::pair<Long,int> > queue[2];
+        for (int u = 0; u < n; ++u)
+        {
+            gain[u] = 0;
+            for (int e = g.xadj[u]; e < g.xadj[u+1]; ++e) {
+                gain[u] += (where[g.adjncy[e]] != where[u]) ? g.adjwgt[e] : -g.adjwgt[e];
+                if (where[g.adjncy[e]] != where[u]) cut += g.adjwgt[e];
+            }
+            queue[where[u]].emplace(-gain[u], u);
+        }
+        cut /= 2;
+
+        std::fill(locked.begin(), locked.end(), 0);
+        moves.clear();
+
+        Long best_over = overload();
+        Long best_cut = cut;
+        std::size_t best_nmoves = 0;
+        const int max_stall = std::max(50, n/20);
+
+        for (int stall = 0; stall < max_stall; )
+        {
+            int from = -1;
+            const Long over0 = pw[0]-limit[0];
+            const Long over1 = pw[1]-limit[1];
+            if (over0 > 0 || over1 > 0)
+            {
+                from = (over0 > over1) ? 0 : 1;
+                if (queue[from].empty()) break;
+            }
+            else
+            {
+                Long best_gain = std::numeric_limits<Long>::lowest();
+                for (int s = 0; s < 2; ++s) {
+                    if (queue[s].empty()) continue;
+                    const int u = queue[s].begin()->second;
+                    if (pw[1-s] + g.vwgt[u] <= limit[1-s] && gain[u] > best_gain) {
+                        best_gain = gain[u];
+                        from = s;
+                    }
+                }
+                if (from < 0) break;
+            }
+
+            const int u = queue[from].begin()->second;
+            queue[from].erase(queue[from].begin());
+            locked[u] = 1;
+            where[u] = 1-from;
+            pw[from]   -= g.vwgt[u];
+            pw[1-from] += g.vwgt[u];
+            cut -= gain[u];
+            moves.push_back(u);
+
+            for (int e = g.xadj[u]; e < g.xadj[u+1]; ++e)
+            {
+                const int v = g.adjncy[e];
+                if (locked[v]) continue;
+                auto& q = queue[where[v]];
+                q.erase(std::make_pair(-gain[v], v));
+                gain[v] += (where[v] == where[u]) ? -2*g.adjwgt[e] : 2*g.adjwgt[e];
+                q.emplace(-gain[v], v);
+            }
+
+            const Long over = overload();
+            if (over < best_over || (over == best_over && cut < best_cut)) {
+                best_over = over;
+                best_cut = cut;
+                best_nmoves = moves.size();
+                stall = 0;
+            } else {
+                ++stall;
+            }
+        }
+
+        for (std::size_t i = moves.size(); i > best_nmoves; --i)
+        {
+            const int u = moves[i-1];
+            pw[where[u]]   -= g.vwgt[u];
+            pw[1-where[u]] += g.vwgt[u];
+            where[u] = 1-where[u];
+        }
+
+        if (best_nmoves == 0) break;
+    }
+}
+
+//
+// Initial bisection by graph growing: starting from seed, side 0 greedily
+// absorbs the frontier vertex that adds the least to the edge cut until it
+// holds target0.
+//
+void
+growBisection (const BoxGraph& g, int seed, Long target0, std::vector<int>& where)
+{
+    const int n = g.size();
+    where.assign(n, 1);
+
+    // Gain of moving u to side 0: edges to side 0 minus edges to side 1
+    std::vector<Long> gain(n);
+    for (int u = 0; u < n; ++u) {
+        gain[u] = 0;
+        for (int e = g.xadj[u]; e < g.xadj[u+1]; ++e) {
+            gain[u] -= g.adjwgt[e];
+        }
+    }
+
+    std::set<std::pair<Long,int> > frontier;
+    std::vector<char> in_frontier(n, 0);
+    frontier.emplace(-gain[seed], seed);
+    in_frontier[seed] = 1;
+
+    Long w0 = 0;
+    int next = 0;
+    while (w0 < target0)
+    {
+        int u;
+        if (frontier.empty()) {
+            // Disconnected graph: continue from any vertex still on side 1.
+            while (next < n && where[next] == 0) ++next;
+            if (next == n) break;
+            u = next;
+        } else {
+            u = frontier.begin()->second;
+            frontier.erase(frontier.begin());
+            in_frontier[u] = 0;
+        }
+
+        if (w0 > 0 && w0 + g.vwgt[u] - target0 > target0 - w0) break;
+
+        where[u] = 0;
+        w0 += g.vwgt[u];
+        for (int e = g.xadj[u]; e < g.xadj[u+1]; ++e)
+        {
+            const int v = g.adjncy[e];
+            if (where[v] == 0) continue;
+            if (in_frontier[v]) {
+                frontier.erase(std::make_pair(-gain[v], v));
+            }
+            gain[v] += 2*g.adjwgt[e];
+            frontier.emplace(-gain[v], v);
+            in_frontier[v] = 1;
+        }
+    }
+}
+
+//
+// Multilevel bisection of g giving side 0 the fraction frac of the weight.
+//
+std::vector<int>
+bisectGraph (const BoxGraph& g, Real frac, Real imbalance)
+{
+    constexpr int coarsen_to = 64;
+    constexpr int nseeds = 8;
+    constexpr int npasses = 8;
+
+    const Long wtot = std::accumulate(g.vwgt.begin(), g.vwgt.end(), Long(0));
+    const Long target[2] = {static_cast<Long>(wtot*frac), wtot - static_cast<Long>(wtot*frac)};
+
+    std::vector<BoxGraph> coarse;
+    std::vector<std::vector<int> > cmaps;
+    const Long maxvwgt = std::max(Long(1), static_cast<Long>(1.5_rt*wtot/coarsen_to));
+    while (true)
+    {
+        const BoxGraph& fine = coarse.empty() ? g : coarse.back();
+        if (fine.size() <= coarsen_to) break;
+        std::vector<int> cmap;
+        BoxGraph cg = coarsenGraph(fine, maxvwgt, cmap);
+        if (cg.size() > 0.9*fine.size()) break;
+        coarse.push_back(std::move(cg));
+        cmaps.push_back(std::move(cmap));
+    }
+
+    // The coarse levels may exceed the limits by one vertex so that the
+    // finer levels have something to balance.
+    auto limits = [&] (const BoxGraph& gl, bool finest, Long* limit) {
+        const Long slack = finest ? 0 : *std::max_element(gl.vwgt.begin(), gl.vwgt.end());
+        for (int s = 0; s < 2; ++s) {
+            limit[s] = static_cast<Long>(target[s]*(1.0_rt+imbalance)) + slack;
+        }
+    };
+
+    std::vector<int> where;
+    {
+        const BoxGraph& gc = coarse.empty() ? g : coarse.back();
+        Long limit[2];
+        limits(gc, coarse.empty(), limit);
+
+        const int n = gc.size();
+        Long best_over = 0, best_cut = 0;
+        std::vector<int> trial;
+        for (int i = 0, ns = std::min(n,nseeds); i < ns; ++i)
+        {
+            growBisection(gc, static_cast<int>((Long(i)*n)/ns), target[0], trial);
+            refineBisection(gc, trial, limit, npasses);
+
+            Long pw[2] = {0, 0};
+            for (int u = 0; u < n; ++u) pw[trial[u]] += gc.vwgt[u];
+            const Long over = std::max({pw[0]-limit[0], pw[1]-limit[1], Long(0)});
+            const Long cut = edgeCut(gc, trial);
+            if (where.empty() || over < best_over || (over == best_over && cut < best_cut)) {
+                best_over = over;
+                best_cut = cut;
+                where = trial;
+            }
+        }
+    }
+
+    // Project back to the finer graphs and refine on each level.
+    for (int lev = static_cast<int>(coarse.size())-1; lev >= 0; --lev)
+    {
+        const BoxGraph& gf = (lev == 0) ? g : coarse[lev-1];
+        const std::vector<int>& cmap = cmaps[lev];
+        std::vector<int> fwhere(gf.size());
+        for (int u = 0; u < gf.size(); ++u) {
+            fwhere[u] = where[cmap[u]];
+        }
+        where = std::move(fwhere);
+
+        Long limit[2];
+        limits(gf, lev == 0, limit);
+        refineBisection(gf, where, limit, npasses);
+    }
+
+    return where;
+}
+
+//
+// Recursive bisection of g into nparts parts numbered from part0.  If unit
+// divides nparts, the splits are made at multiples of unit so that every
+// group of unit consecutive parts (i.e., a node) receives a connected region.
+//
+void
+partitionGraph (const BoxGraph& g, const std::vector<int>& gid, int nparts, int part0,
+                int unit, Real imbalance, std::vector<int>& part)
+{
+    if (g.size() == 0) return;
+
+    if (nparts == 1)
+    {
+        for (int u = 0; u < g.size(); ++u) {
+            part[gid[u]] = part0;
+        }
+        return;
+    }
+
+    int n0 = nparts/2;
+    if (unit > 1 && nparts > unit && nparts % unit == 0) {
+        n0 = unit * ((nparts/unit)/2);
+    }
+
+    std::vector<int> where = bisectGraph(g, Real(n0)/Real(nparts), imbalance);
+
+    for (int s = 0; s < 2; ++s)
+    {
+        std::vector<int> sub_gid;
+        BoxGraph sg = subGraph(g, where, s, gid, sub_gid);
+        partitionGraph(sg, sub_gid, (s == 0) ? n0 : nparts-n0, (s == 0) ? part0 : part0+n0,
+                       unit, imbalance, part);
+    }
+}
+
+//
+// The imbalance of the recursive bisections compounds.  Move boxes out of the
+// heaviest part, preferring a neighboring part that shares the most ghost
+// cells with them, until every part is within the limit.  If no part can take
+// a box without exceeding the limit, the box that evens out the heaviest and
+// the lightest part the most goes to the lightest part.
+//
+void
+balanceParts (const BoxGraph& g, int nparts, Real imbalance, std::vector<int>& part)
+{
+    const int n = g.size();
+    const Long wtot = std::accumulate(g.vwgt.begin(), g.vwgt.end(), Long(0));
+    const Long limit = static_cast<Long>(Real(wtot)/nparts*(1.0_rt+imbalance));
+
+    std::vector<Long> pw(nparts, 0);
+    std::vector<std::vector<int> > members(nparts);
+    for (int u = 0; u < n; ++u) {
+        pw[part[u]] += g.vwgt[u];
+        members[part[u]].push_back(u);
+    }
+
+    std::map<int,Long> conn;
+    while (true)
+    {
+        const int p = static_cast<int>(std::max_element(pw.begin(), pw.end()) - pw.begin());
+        if (pw[p] <= limit) break;
+        const int lightest = static_cast<int>(std::min_element(pw.begin(), pw.end()) - pw.begin());
+
+        int best_u = -1, best_q = -1;
+        Long best_dcut = std::numeric_limits<Long>::max();
+        int even_u = -1;
+        Long even_max = pw[p];
+        for (int u : members[p])
+        {
+            conn.clear();
+            for (int e = g.xadj[u]; e < g.xadj[u+1]; ++e) {
+                conn[part[g.adjncy[e]]] += g.adjwgt[e];
+            }
+            const Long internal = conn.count(p) ? conn[p] : 0;
+            for (const auto& kv : conn) {
+                const int q = kv.first;
+                if (q != p && pw[q] + g.vwgt[u] <= limit && internal - kv.second < best_dcut) {
+                    best_dcut = internal - kv.second;
+                    best_u = u;
+                    best_q = q;
+                }
+            }
+            if (pw[lightest] + g.vwgt[u] <= limit && internal < best_dcut) {
+                best_dcut = internal;
+                best_u = u;
+                best_q = lightest;
+            }
+            const Long new_max = std::max(pw[p] - g.vwgt[u], pw[lightest] + g.vwgt[u]);
+            if (new_max < even_max) {
+                even_max = new_max;
+                even_u = u;
+            }
+        }
+        if (best_u < 0) {
+            best_u = even_u;
+            best_q = lightest;
+        }
+        if (best_u < 0) break;
+
+        pw[p] -= g.vwgt[best_u];
+        pw[best_q] += g.vwgt[best_u];
+        part[best_u] = best_q;
+        members[p].erase(std::find(members[p].begin(), members[p].end(), best_u));
+        members[best_q].push_back(best_u);
+    }
+}
+
+}
+
+void
+DistributionMapping::GraphProcessorMap (const BoxArray&          boxes,
+                                        const std::vector<Long>& wgts,
+                                        int                      nprocs,
+                                        Real*                    eff)
+{
+    BL_PROFILE("DistributionMapping::GraphProcessorMap()");
+
+    BL_ASSERT(boxes.size() > 0);
+    BL_ASSERT(boxes.size() == static_cast<int>(wgts.size()));
+
+    m_ref->clear();
+    m_ref->m_pmap.resize(wgts.size());
+
+    // Without any cost, balance the number of boxes.
+    std::vector<Long> unit_wgts;
+    if (std::all_of(wgts.begin(), wgts.end(), [] (Long w) { return w == 0; })) {
+        unit_wgts.assign(wgts.size(), 1);
+    }
+    const std::vector<Long>& w = unit_wgts.empty() ? wgts : unit_wgts;
+
+    const int N = boxes.size();
+    const BoxGraph g = makeBoxGraph(boxes, w, IntVect(graph_ngrow));
+
+    int unit = 1;
+    if (node_size > 0 && nprocs % node_size == 0) {
+        unit = node_size;
+    }
+
+    int nlevels = 1;
+    while ((1 << nlevels) < nprocs) ++nlevels;
+
+    std::vector<int> gid(N);
+    std::iota(gid.begin(), gid.end(), 0);
+    std::vector<int> part(N, 0);
+    partitionGraph(g, gid, nprocs, 0, unit, graph_imbalance/nlevels, part);
+    balanceParts(g, nprocs, graph_imbalance, part);
+
+    // Consecutive parts share the most ghost cells, so give them to ranks on
+    // the same node.
+    Vector<int> ord(nprocs);
+    std::iota(ord.begin(), ord.end(), 0);
+#ifdef BL_USE_MPI
+    if (graph_node_aware) {
+        Vector<int> nbh = machine::find_best_nbh(nprocs, true);
+        if (static_cast<int>(nbh.size()) == nprocs) {
+            ord = std::move(nbh);
+        }
+    }
+#endif
+
+    for (int i = 0; i < N; ++i) {
+        m_ref->m_pmap[i] = ParallelContext::local_to_global_rank(ord[part[i]]);
+    }
+
+    if (eff || verbose)
+    {
+        std::vector<Long> pw(nprocs, 0);
+        for (int i = 0; i < N; ++i) {
+            pw[part[i]] += w[i];
+        }
+        const Real sum_wgt = static_cast<Real>(std::accumulate(pw.begin(), pw.end(), Long(0)));
+        const Real max_wgt = static_cast<Real>(*std::max_element(pw.begin(), pw.end()));
+        Real efficiency = sum_wgt/(nprocs*max_wgt);
+        if (eff) *eff = efficiency;
+
+        if (verbose)
+        {
+            amrex::Print() << "GRAPH efficiency: " << efficiency
+                           << ", edge cut: " << edgeCut(g, part) << '\n';
+        }
+    }
+}
+
+void
+DistributionMapping::GraphProcessorMap (const BoxArray& boxes,
+                                        int             nprocs)
+{
+    BL_ASSERT(boxes.size() > 0);
+
+    std::vector<Long> wgts;
+
+    wgts.reserve(boxes.size());
+
+    for (int i = 0, N = boxes.size(); i < N; ++i)
+    {
+        wgts.push_back(boxes[i].volume());
+    }
+
+    GraphProcessorMap(boxes,wgts,nprocs);
+}
+
 DistributionMapping
 DistributionMapping::makeKnapSack (const Vector<Real>& rcost, int nmax)
 {
@@ -1557,6 +2211,39 @@ DistributionMapping::ComputeDistributionMappingEfficiency (const DistributionMap
                                    rankToCost.end(), 0.0_rt) / (nprocs*maxCost));
 }
 
+void
+DistributionMapping::ComputeDistributionMappingEdgeCut (const DistributionMapping& dm,
+                                                        const BoxArray& ba,
+                                                        const IntVect& ngrow,
+                                                        Long* edgecut,
+                                                        Long* node_edgecut)
+{
+    BL_PROFILE("DistributionMapping::ComputeDistributionMappingEdgeCut()");
+
+    Long cut = 0, node_cut = 0;
+
+    std::vector<std::pair<int,Box> > isects;
+
+    for (int i = 0, N = ba.size(); i < N; ++i)
+    {
+        ba.intersections(amrex::grow(ba[i],ngrow), isects);
+
+        for (const auto& is : isects)
+        {
+            const int j = is.first;
+            if (j == i || dm[j] == dm[i]) continue;
+
+            cut += is.second.numPts();
+            if (node_size <= 0 || dm[j]/node_size != dm[i]/node_size) {
+                node_cut += is.second.numPts();
+            }
+        }
+    }
+
+    if (edgecut) *edgecut = cut;
+    if (node_edgecut) *node_edgecut = node_cut;
+}
+
 namespace {
 Vector<Long>
 gather_weights (const MultiFab& weight)
@@ -1788,6 +2475,244 @@ DistributionMapping::makeSFC (const BoxArray& ba, bool use_box_vol, const int np
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeGraph (const MultiFab& weight, Real& eff)
+{
+    BL_PROFILE("makeGraph");
+    Vector<Long> cost = gather_weights(weight);
+    int nprocs = ParallelContext::NProcsSub();
+    DistributionMapping r;
+    r.GraphProcessorMap(weight.boxArray(), cost, nprocs, &eff);
+    return r;
+}
+
+DistributionMapping
+DistributionMapping::makeGraph (const Vector<Real>& rcost, const BoxArray& ba, Real& eff)
+{
+    BL_PROFILE("makeGraph");
+
+    DistributionMapping r;
+
+    std::vector<Long> cost(rcost.size());
+
+    Real wmax = *std::max_element(rcost.begin(), rcost.end());
+    Real scale = (wmax == 0) ? 1.e9_rt : 1.e9_rt/wmax;
+
+    for (int i = 0; i < rcost.size(); ++i) {
+        cost[i] = Long(rcost[i]*scale) + 1L;
+    }
+
+    int nprocs = ParallelContext::NProcsSub();
+
+    r.GraphProcessorMap(ba, cost, nprocs, &eff);
+
+    return r;
+}
+
+namespace {
+
+//
+// Greedy migration: repeatedly move one box from the most to the least loaded
+// rank until the most loaded rank is within the target.  A box that brings
+// the most loaded rank down to the target on its own is preferred, then the
+// box with the most cost per byte, and if no box fits on the least loaded
+// rank the one that evens the two ranks out the most.  Every move decreases
+// the sum of the squared loads, so this terminates.
+//
+void
+rebalanceDoIt (Vector<int>& pmap, const std::vector<Long>& wgts,
+               const std::vector<Long>& bytes, int nprocs, Real target_efficiency,
+               Real& current_efficiency, Real& proposed_efficiency, Long& moved_bytes)
+{
+    BL_PROFILE("DistributionMapping::rebalanceDoIt()");
+
+    const Vector<int> oldpmap = pmap;
+    const int N = static_cast<int>(pmap.size());
+
+    std::vector<Long> load(nprocs, 0);
+    std::vector<std::vector<int> > boxes(nprocs);
+    for (int i = 0; i < N; ++i) {
+        load[pmap[i]] += wgts[i];
+        boxes[pmap[i]].push_back(i);
+    }
+
+    const Long total = std::accumulate(load.begin(), load.end(), Long(0));
+    auto efficiency = [&] () {
+        const Long maxload = *std::max_element(load.begin(), load.end());
+        return (maxload > 0) ? Real(total)/(Real(nprocs)*Real(maxload)) : 1.0_rt;
+    };
+    current_efficiency = efficiency();
+
+    const Real target = Real(total)/(Real(nprocs)*std::min(target_efficiency, 1.0_rt));
+
+    std::set<std::pair<Long,int> > ranks;
+    for (int r = 0; r < nprocs; ++r) {
+        ranks.emplace(load[r], r);
+    }
+
+    while (nprocs > 1)
+    {
+        const int p = ranks.rbegin()->second;
+        const int q = ranks.begin()->second;
+        if (Real(load[p]) <= target) break;
+
+        const Real excess = Real(load[p]) - target;
+        const Real room = target - Real(load[q]);
+
+        int finishing = -1, dense = -1, even = -1;
+        Long even_max = load[p];
+        for (int i : boxes[p])
+        {
+            const Long w = wgts[i];
+            if (load[q] + w >= load[p]) continue;
+            if (Real(w) <= room) {
+                if (Real(w) >= excess) {
+                    if (finishing < 0 || bytes[i] < bytes[finishing]) {
+                        finishing = i;
+                    }
+                } else if (dense < 0 ||
+                           Real(w)*Real(bytes[dense]+1) > Real(wgts[dense])*Real(bytes[i]+1)) {
+                    dense = i;
+                }
+            }
+            const Long new_max = std::max(load[p] - w, load[q] + w);
+            if (new_max < even_max || (new_max == even_max && even >= 0 && bytes[i] < bytes[even])) {
+                even_max = new_max;
+                even = i;
+            }
+        }
+
+        const int i = (finishing >= 0) ? finishing : ((dense >= 0) ? dense : even);
+        if (i < 0) break;
+
+        ranks.erase(std::make_pair(load[p], p));
+        ranks.erase(std::make_pair(load[q], q));
+        load[p] -= wgts[i];
+        load[q] += wgts[i];
+        ranks.emplace(load[p], p);
+        ranks.emplace(load[q], q);
+
+        boxes[p].erase(std::find(boxes[p].begin(), boxes[p].end(), i));
+        boxes[q].push_back(i);
+        pmap[i] = q;
+    }
+
+    proposed_efficiency = efficiency();
+
+    moved_bytes = 0;
+    for (int i = 0; i < N; ++i) {
+        if (pmap[i] != oldpmap[i]) moved_bytes += bytes[i];
+    }
+}
+
+}
+
+DistributionMapping
+DistributionMapping::makeRebalance (const DistributionMapping& dm,
+                                    const Vector<Real>& rcost,
+                                    const Vector<Long>& bytes,
+                                    Real target_efficiency,
+                                    Real& currentEfficiency,
+                                    Real& proposedEfficiency,
+                                    Long& movedBytes)
+{
+    BL_PROFILE("makeRebalance");
+
+    AMREX_ASSERT(dm.size() == rcost.size() && dm.size() == bytes.size());
+
+    std::vector<Long> cost(rcost.size());
+
+    Real wmax = *std::max_element(rcost.begin(), rcost.end());
+    Real scale = (wmax == 0) ? 1.e9_rt : 1.e9_rt/wmax;
+
+    for (int i = 0; i < rcost.size(); ++i) {
+        cost[i] = Long(rcost[i]*scale) + 1L;
+    }
+
+    Vector<int> pmap = dm.ProcessorMap();
+    rebalanceDoIt(pmap, cost, bytes, ParallelDescriptor::NProcs(), target_efficiency,
+                  currentEfficiency, proposedEfficiency, movedBytes);
+
+    return DistributionMapping(std::move(pmap));
+}
+
+DistributionMapping
+DistributionMapping::makeRebalance (const MultiFab& weight,
+                                    Long bytes_per_cell,
+                                    Real target_efficiency,
+                                    Real& currentEfficiency,
+                                    Real& proposedEfficiency,
+                                    Long& movedBytes)
+{
+    BL_PROFILE("makeRebalance");
+
+    Vector<Long> cost = gather_weights(weight);
+
+    const BoxArray& ba = weight.boxArray();
+    std::vector<Long> bytes(ba.size());
+    for (int i = 0; i < ba.size(); ++i) {
+        bytes[i] = ba[i].numPts() * bytes_per_cell;
+    }
+
+    Vector<int> pmap = weight.DistributionMap().ProcessorMap();
+    rebalanceDoIt(pmap, cost, bytes, ParallelDescriptor::NProcs(), target_efficiency,
+                  currentEfficiency, proposedEfficiency, movedBytes);
+
+    return DistributionMapping(std::move(pmap));
+}
+
+DistributionMapping
+DistributionMapping::makeRebalance (const LayoutData<Real>& rcost_local,
+                                    Long bytes_per_cell,
+                                    Real target_efficiency,
+                                    Real& currentEfficiency,
+                                    Real& proposedEfficiency,
+                                    Long& movedBytes,
+                                    bool broadcastToAll, int root)
+{
+    BL_PROFILE("makeRebalance");
+
+    Vector<Real> rcost(rcost_local.size());
+    ParallelDescriptor::GatherLayoutDataToVector<Real>(rcost_local, rcost, root);
+    // rcost is now filled out on root
+
+    DistributionMapping r;
+    if (ParallelDescriptor::MyProc() == root)
+    {
+        const BoxArray& ba = rcost_local.boxArray();
+        Vector<Long> bytes(ba.size());
+        for (int i = 0; i < ba.size(); ++i) {
+            bytes[i] = ba[i].numPts() * bytes_per_cell;
+        }
+
+        r = makeRebalance(rcost_local.DistributionMap(), rcost, bytes, target_efficiency,
+                          currentEfficiency, proposedEfficiency, movedBytes);
+    }
+
+#ifdef BL_USE_MPI
+    // The new distribution mapping is computed on root; broadcast it to all
+    // procs (optional)
+    if (broadcastToAll)
+    {
+        Vector<int> pmap(rcost_local.DistributionMap().size());
+        if (ParallelDescriptor::MyProc() == root)
+        {
+            pmap = r.ProcessorMap();
+        }
+
+        ParallelDescriptor::Bcast(&pmap[0], pmap.size(), root);
+        if (ParallelDescriptor::MyProc() != root)
+        {
+            r = DistributionMapping(pmap);
+        }
+    }
+#else
+    amrex::ignore_unused(broadcastToAll);
+#endif
+
+    return r;
+}
+
 const Vector<int>&
 DistributionMapping::getIndexArray ()
 {
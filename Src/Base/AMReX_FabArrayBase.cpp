@@ -31,6 +31,7 @@ namespace amrex {
 // Set default values in Initialize()!!!
 //
 int     FabArrayBase::MaxComp;
+bool    FabArrayBase::use_persistent_fb = false;
 
 #if defined(AMREX_USE_GPU)
 
@@ -62,6 +63,10 @@ IntVect FabArrayBase::comm_tile_size(AMREX_D_DECL(1024000, 8, 8));
 
 FabArrayBase::TACache              FabArrayBase::m_TheTileArrayCache;
 FabArrayBase::FBCache              FabArrayBase::m_TheFBCache;
+#ifdef BL_USE_MPI
+MPI_Comm                           FabArrayBase::m_persistent_fb_comm = MPI_COMM_NULL;
+namespace { int s_persistent_fb_tag = -1; }
+#endif
 FabArrayBase::CPCache              FabArrayBase::m_TheCPCache;
 FabArrayBase::RB90Cache            FabArrayBase::m_TheRB90Cache;
 FabArrayBase::RB180Cache           FabArrayBase::m_TheRB180Cache;
@@ -123,6 +128,18 @@ FabArrayBase::Initialize ()
         MaxComp = 1;
     }
 
+    pp.queryAdd("use_persistent_fb", FabArrayBase::use_persistent_fb);
+#ifdef BL_USE_MPI
+    if (use_persistent_fb) {
+        // Persistent requests use their own communicator so that their
+        // fixed tags cannot match messages tagged with SeqNum().
+        BL_MPI_REQUIRE(MPI_Comm_dup(ParallelDescriptor::Communicator(), &m_persistent_fb_comm));
+        s_persistent_fb_tag = ParallelDescriptor::MinTag();
+    }
+#else
+    use_persistent_fb = false;
+#endif
+
 #ifdef AMREX_USE_GPU
     if (ParallelDescriptor::UseGpuAwareMpi()) {
         the_fa_arena = The_Arena();
@@ -1172,6 +1189,29 @@ FabArrayBase::FB::define_os (const FabArrayBase& fa)
 FabArrayBase::FB::~FB ()
 {}
 
+#ifdef BL_USE_MPI
+FabArrayBase::FB::PersistentComm::~PersistentComm ()
+{
+    for (auto& req : send_reqs) {
+        if (req != MPI_REQUEST_NULL) { MPI_Request_free(&req); }
+    }
+    for (auto& req : recv_reqs) {
+        if (req != MPI_REQUEST_NULL) { MPI_Request_free(&req); }
+    }
+    if (the_send_data) { The_FA_Arena()->free(the_send_data); }
+    if (the_recv_data) { The_FA_Arena()->free(the_recv_data); }
+}
+
+int
+FabArrayBase::getPersistentFBTag ()
+{
+    int cur_tag = s_persistent_fb_tag;
+    s_persistent_fb_tag = (s_persistent_fb_tag < ParallelDescriptor::MaxTag()) ?
+        s_persistent_fb_tag + 1 : ParallelDescriptor::MinTag();
+    return cur_tag;
+}
+#endif
+
 void
 FabArrayBase::flushFB (bool no_assertion) const
 {
@@ -2205,6 +2245,11 @@ void
 FabArrayBase::Finalize ()
 {
     FabArrayBase::flushFBCache();
+#ifdef BL_USE_MPI
+    if (m_persistent_fb_comm != MPI_COMM_NULL) {
+        MPI_Comm_free(&m_persistent_fb_comm);
+    }
+#endif
     FabArrayBase::flushCPCache();
     FabArrayBase::flushRB90Cache();
     FabArrayBase::flushRB180Cache();
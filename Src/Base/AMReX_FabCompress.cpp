@@ -0,0 +1,205 @@
+
+#include <AMReX_FabCompress.H>
+#include <AMReX.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_Extension.H>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace amrex {
+namespace FabCompress {
+
+namespace {
+
+    constexpr Long min_match  = 4;
+    constexpr Long max_offset = 65535;
+    constexpr int  hash_bits  = 16;
+
+    std::uint32_t read32 (const unsigned char* p) noexcept
+    {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    int hash4 (std::uint32_t v) noexcept
+    {
+        return static_cast<int>((v * 2654435761u) >> (32 - hash_bits));
+    }
+
+    //
+    // A sequence is a token, optional extra literal length bytes, the
+    // literals, and, unless it is the last sequence, a two byte offset and
+    // optional extra match length bytes.  The high nibble of the token is
+    // the number of literals and the low nibble is the match length minus
+    // min_match.  A nibble of 15 is followed by bytes that are added to it
+    // until a byte less than 255 is seen.
+    //
+    void put_length (Vector<char>& dst, Long len)
+    {
+        while (len >= 255) {
+            dst.push_back(static_cast<char>(255));
+            len -= 255;
+        }
+        dst.push_back(static_cast<char>(len));
+    }
+
+    void put_sequence (Vector<char>& dst, const unsigned char* lit, Long nlit,
+                       Long offset, Long mlen)
+    {
+        const Long mcode = (mlen > 0) ? mlen - min_match : 0;
+        const int token = (static_cast<int>(std::min(nlit, Long(15))) << 4)
+                        |  static_cast<int>(std::min(mcode, Long(15)));
+        dst.push_back(static_cast<char>(token));
+        if (nlit >= 15) put_length(dst, nlit-15);
+        dst.insert(dst.end(), lit, lit+nlit);
+        if (mlen > 0) {
+            dst.push_back(static_cast<char>(offset & 0xff));
+            dst.push_back(static_cast<char>(offset >> 8));
+            if (mcode >= 15) put_length(dst, mcode-15);
+        }
+    }
+
+    Long get_length (const unsigned char*& ip, const unsigned char* iend)
+    {
+        Long len = 0;
+        unsigned char b;
+        do {
+            if (ip >= iend) amrex::Error("FabCompress::decompress: corrupt data");
+            b = *ip++;
+            len += b;
+        } while (b == 255);
+        return len;
+    }
+
+    void lz_compress (const unsigned char* src, Long n, Vector<char>& dst)
+    {
+        Vector<Long> table(Long(1) << hash_bits, -1);
+        Long anchor = 0;
+        Long ip = 0;
+        while (ip + min_match <= n)
+        {
+            const std::uint32_t seq = read32(src+ip);
+            const int h = hash4(seq);
+            const Long ref = table[h];
+            table[h] = ip;
+            if (ref < 0 || ip - ref > max_offset || read32(src+ref) != seq) {
+                // Skip ahead faster through data that does not compress.
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+            Long mlen = min_match;
+            while (ip + mlen < n && src[ref+mlen] == src[ip+mlen]) {
+                ++mlen;
+            }
+            put_sequence(dst, src+anchor, ip-anchor, ip-ref, mlen);
+            ip += mlen;
+            anchor = ip;
+        }
+        put_sequence(dst, src+anchor, n-anchor, 0, 0);
+    }
+
+    void lz_decompress (const unsigned char* ip, Long csize, unsigned char* dst, Long n)
+    {
+        const unsigned char* iend = ip + csize;
+        unsigned char* op = dst;
+        unsigned char* oend = dst + n;
+        while (true)
+        {
+            if (ip >= iend) amrex::Error("FabCompress::decompress: corrupt data");
+            const int token = *ip++;
+
+            Long nlit = token >> 4;
+            if (nlit == 15) nlit += get_length(ip, iend);
+            if (nlit > iend-ip || nlit > oend-op) {
+                amrex::Error("FabCompress::decompress: corrupt data");
+            }
+            std::memcpy(op, ip, nlit);
+            op += nlit;
+            ip += nlit;
+
+            if (op == oend) break;
+
+            if (iend-ip < 2) amrex::Error("FabCompress::decompress: corrupt data");
+            const Long offset = Long(ip[0]) | (Long(ip[1]) << 8);
+            ip += 2;
+            Long mlen = (token & 15);
+            if (mlen == 15) mlen += get_length(ip, iend);
+            mlen += min_match;
+            if (offset == 0 || offset > op-dst || mlen > oend-op) {
+                amrex::Error("FabCompress::decompress: corrupt data");
+            }
+            // The match may overlap the output, so copy byte by byte.
+            const unsigned char* m = op - offset;
+            for (Long i = 0; i < mlen; ++i) {
+                op[i] = m[i];
+            }
+            op += mlen;
+        }
+    }
+}
+
+Long
+compress (const char* src, Long nbytes, int word_size, Vector<char>& dst)
+{
+    AMREX_ASSERT(word_size > 0 && nbytes % word_size == 0);
+
+    const Long start = dst.size();
+    dst.push_back(ShuffleLZ);
+
+    if (nbytes > 0)
+    {
+        const Long nwords = nbytes / word_size;
+        Vector<unsigned char> shuffled(nbytes);
+        for (int b = 0; b < word_size; ++b) {
+            unsigned char* AMREX_RESTRICT p = shuffled.data() + b*nwords;
+            for (Long i = 0; i < nwords; ++i) {
+                p[i] = static_cast<unsigned char>(src[i*word_size+b]);
+            }
+        }
+        lz_compress(shuffled.data(), nbytes, dst);
+    }
+
+    if (static_cast<Long>(dst.size()) - start - 1 >= nbytes) {
+        dst.resize(start);
+        dst.push_back(Stored);
+        dst.insert(dst.end(), src, src+nbytes);
+    }
+
+    return static_cast<Long>(dst.size()) - start;
+}
+
+void
+decompress (const char* src, Long csize, char* dst, Long nbytes, int word_size)
+{
+    AMREX_ASSERT(word_size > 0 && nbytes % word_size == 0);
+
+    if (csize < 1) amrex::Error("FabCompress::decompress: corrupt data");
+
+    if (src[0] == Stored)
+    {
+        if (csize-1 != nbytes) amrex::Error("FabCompress::decompress: corrupt data");
+        std::memcpy(dst, src+1, nbytes);
+    }
+    else if (src[0] == ShuffleLZ)
+    {
+        const Long nwords = nbytes / word_size;
+        Vector<unsigned char> shuffled(nbytes);
+        lz_decompress(reinterpret_cast<const unsigned char*>(src+1), csize-1,
+                      shuffled.data(), nbytes);
+        for (int b = 0; b < word_size; ++b) {
+            const unsigned char* AMREX_RESTRICT p = shuffled.data() + b*nwords;
+            for (Long i = 0; i < nwords; ++i) {
+                dst[i*word_size+b] = static_cast<char>(p[i]);
+            }
+        }
+    }
+    else
+    {
+        amrex::Error("FabCompress::decompress: unknown method");
+    }
+}
+
+}}
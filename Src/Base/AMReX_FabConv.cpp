@@ -5,6 +5,8 @@
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -13,6 +15,7 @@
 namespace amrex {
 
 bool RealDescriptor::bAlwaysFixDenormals (false);
+bool RealDescriptor::bUseFastConversion (true);
 int  RealDescriptor::writeBufferSize(262144);  // ---- these are number of reals,
 int  RealDescriptor::readBufferSize(262144);   // ---- not bytes
 
@@ -150,6 +153,18 @@ RealDescriptor::SetFixDenormals()
     bAlwaysFixDenormals = true;
 }
 
+void
+RealDescriptor::SetFastConversion(bool flag)
+{
+    bUseFastConversion = flag;
+}
+
+bool
+RealDescriptor::UseFastConversion()
+{
+    return bUseFastConversion;
+}
+
 void
 RealDescriptor::SetReadBufferSize(int rbs)
 {
@@ -912,6 +927,146 @@ operator>> (std::istream&   is,
     return is;
 }
 
+//
+// Fast paths for conversions between IEEE floats and doubles in big or
+// little endian order.  These cover the byte swaps and the narrowing and
+// widening conversions that are common in FAB I/O.  The loops are written
+// so that the compiler can vectorize them.
+//
+
+namespace {
+
+    inline std::uint32_t byte_swap (std::uint32_t x) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap32(x);
+#else
+        return ((x & 0x000000FFu) << 24) | ((x & 0x0000FF00u) <<  8)
+            |  ((x & 0x00FF0000u) >>  8) | ((x & 0xFF000000u) >> 24);
+#endif
+    }
+
+    inline std::uint64_t byte_swap (std::uint64_t x) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(x);
+#else
+        return (std::uint64_t(byte_swap(std::uint32_t(x))) << 32)
+            |   std::uint64_t(byte_swap(std::uint32_t(x >> 32)));
+#endif
+    }
+
+    template <typename T> struct UIntOf {};
+    template <> struct UIntOf<float>  { using type = std::uint32_t; };
+    template <> struct UIntOf<double> { using type = std::uint64_t; };
+
+    template <typename TI, typename TO, bool SwapIn, bool SwapOut>
+    void fast_convert (void* out, const void* in, Long nitems)
+    {
+        using UI = typename UIntOf<TI>::type;
+        using UO = typename UIntOf<TO>::type;
+        const char* AMREX_RESTRICT pin  = static_cast<const char*>(in);
+        char*       AMREX_RESTRICT pout = static_cast<char*>(out);
+        AMREX_PRAGMA_SIMD
+        for (Long i = 0; i < nitems; ++i)
+        {
+            UI u;
+            std::memcpy(&u, pin + i*sizeof(UI), sizeof(UI));
+            if (SwapIn) u = byte_swap(u);
+            TI x;
+            std::memcpy(&x, &u, sizeof(TI));
+            // Narrowing rounds to nearest even, as required by IEEE 754.
+            const auto y = static_cast<TO>(x);
+            UO v;
+            std::memcpy(&v, &y, sizeof(UO));
+            if (SwapOut) v = byte_swap(v);
+            std::memcpy(pout + i*sizeof(UO), &v, sizeof(UO));
+        }
+    }
+
+    template <typename TI, typename TO>
+    void fast_convert (void* out, const void* in, Long nitems, bool swap_in, bool swap_out)
+    {
+        if (swap_in && swap_out) {
+            fast_convert<TI,TO,true ,true >(out, in, nitems);
+        } else if (swap_in) {
+            fast_convert<TI,TO,true ,false>(out, in, nitems);
+        } else if (swap_out) {
+            fast_convert<TI,TO,false,true >(out, in, nitems);
+        } else {
+            fast_convert<TI,TO,false,false>(out, in, nitems);
+        }
+    }
+
+    //
+    // Returns the size of an IEEE float or double in normal or reverse
+    // order, and whether its bytes are swapped relative to this machine.
+    // Returns 0 for any other format.
+    //
+    int ieee_size (const RealDescriptor& rd, bool& swapped)
+    {
+        const Vector<Long>& fmt = rd.formatarray();
+        const Vector<int>&  ord = rd.orderarray();
+        const int nb = static_cast<int>(ord.size());
+        const Long* ieee_fmt;
+        const int* normal_ord;
+        const int* reverse_ord;
+        const RealDescriptor* native;
+        if (nb == 4) {
+            ieee_fmt = FPC::ieee_float;
+            normal_ord = FPC::normal_float_order;
+            reverse_ord = FPC::reverse_float_order;
+            native = &FPC::Native32RealDescriptor();
+        } else if (nb == 8) {
+            ieee_fmt = FPC::ieee_double;
+            normal_ord = FPC::normal_double_order;
+            reverse_ord = FPC::reverse_double_order;
+            native = &FPC::Native64RealDescriptor();
+        } else {
+            return 0;
+        }
+        if (fmt.size() != 8 || ! std::equal(fmt.begin(), fmt.end(), ieee_fmt)) {
+            return 0;
+        }
+        if (! std::equal(ord.begin(), ord.end(), normal_ord) &&
+            ! std::equal(ord.begin(), ord.end(), reverse_ord)) {
+            return 0;
+        }
+        swapped = (ord != native->orderarray());
+        return nb;
+    }
+}
+
+static
+bool
+PD_fastconvert (void*                 out,
+                const void*           in,
+                Long                  nitems,
+                const RealDescriptor& ord,
+                const RealDescriptor& ird)
+{
+    static_assert(std::numeric_limits<float>::is_iec559 &&
+                  std::numeric_limits<double>::is_iec559,
+                  "PD_fastconvert: float and double must be IEEE 754");
+
+    bool swap_in = false, swap_out = false;
+    const int nbin  = ieee_size(ird, swap_in);
+    const int nbout = ieee_size(ord, swap_out);
+
+    if (nbin == 8 && nbout == 8) {
+        fast_convert<double,double>(out, in, nitems, swap_in, swap_out);
+    } else if (nbin == 8 && nbout == 4) {
+        fast_convert<double,float >(out, in, nitems, swap_in, swap_out);
+    } else if (nbin == 4 && nbout == 8) {
+        fast_convert<float ,double>(out, in, nitems, swap_in, swap_out);
+    } else if (nbin == 4 && nbout == 4) {
+        fast_convert<float ,float >(out, in, nitems, swap_in, swap_out);
+    } else {
+        return false;
+    }
+    return true;
+}
+
 static
 void
 PD_convert (void*                 out,
@@ -930,6 +1085,11 @@ PD_convert (void*                 out,
         BL_ASSERT(int(n) == nitems);
         memcpy(out, in, n*ord.numBytes());
     }
+    else if (boffs == 0 && ! onescmp && RealDescriptor::UseFastConversion() &&
+             PD_fastconvert(out, in, nitems, ord, ird))
+    {
+        // Done
+    }
     else if (ord.formatarray() == ird.formatarray() && boffs == 0 && ! onescmp) {
         permute_real_word_order(out, in, nitems,
                                 ord.order(), ird.order(), ord.numBytes());
@@ -2,6 +2,8 @@
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_VisMF.H>
 #include <algorithm>
+#include <cmath>
+#include <numeric>
 
 namespace amrex {
 
@@ -123,6 +125,153 @@ PlotFileDataImpl::get (int level) noexcept
     return mf;
 }
 
+Vector<int>
+PlotFileDataImpl::componentIndices (Vector<std::string> const& varnames) const
+{
+    Vector<int> comps;
+    if (varnames.empty()) {
+        comps.resize(m_ncomp);
+        std::iota(comps.begin(), comps.end(), 0);
+    } else {
+        for (auto const& varname : varnames) {
+            auto r = std::find(std::begin(m_var_names), std::end(m_var_names), varname);
+            if (r == std::end(m_var_names)) {
+                amrex::Abort("PlotFileDataImpl::get: varname not found "+varname);
+            }
+            comps.push_back(static_cast<int>(std::distance(std::begin(m_var_names), r)));
+        }
+    }
+    return comps;
+}
+
+void
+PlotFileDataImpl::readFABs (int level, MultiFab& mf, Vector<int> const& gids,
+                            Vector<int> const& comps)
+{
+    // Reading all the components in their order takes a single read per FAB;
+    // otherwise every component is read from its offset in the FAB.
+    bool all_comps = static_cast<int>(comps.size()) == m_ncomp;
+    for (int i = 0; all_comps && i < comps.size(); ++i) {
+        all_comps = comps[i] == i;
+    }
+
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const int gid = gids[mfi.index()];
+        FArrayBox& dstfab = mf[mfi];
+        if (all_comps) {
+            std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, m_mf_name[level]));
+            dstfab.copy<RunOn::Host>(*srcfab);
+        } else {
+            for (int n = 0; n < comps.size(); ++n) {
+                std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, comps[n]));
+                dstfab.copy<RunOn::Host>(*srcfab, 0, n, 1);
+            }
+        }
+    }
+}
+
+MultiFab
+PlotFileDataImpl::get (int level, Vector<std::string> const& varnames) noexcept
+{
+    const Vector<int> comps = componentIndices(varnames);
+    MultiFab mf(m_ba[level], m_dmap[level], comps.size(), m_ngrow[level]);
+    Vector<int> gids(m_ba[level].size());
+    std::iota(gids.begin(), gids.end(), 0);
+    readFABs(level, mf, gids, comps);
+    return mf;
+}
+
+MultiFab
+PlotFileDataImpl::get (int level, Box const& region, Vector<std::string> const& varnames) noexcept
+{
+    const Vector<int> comps = componentIndices(varnames);
+
+    const BoxArray& ba = m_ba[level];
+    const Box r = amrex::convert(region, ba.ixType());
+    BoxList bl(ba.ixType());
+    Vector<int> gids;
+    for (int i = 0, N = static_cast<int>(ba.size()); i < N; ++i) {
+        if (ba[i].intersects(r)) {
+            bl.push_back(ba[i]);
+            gids.push_back(i);
+        }
+    }
+
+    MultiFab mf;
+    if (!gids.empty()) {
+        BoxArray subba(std::move(bl));
+        mf.define(subba, DistributionMapping{subba}, comps.size(), m_ngrow[level]);
+        readFABs(level, mf, gids, comps);
+    }
+    return mf;
+}
+
+MultiFab
+PlotFileDataImpl::get (int level, RealBox const& region, Vector<std::string> const& varnames) noexcept
+{
+    return get(level, regionBox(level, region), varnames);
+}
+
+Box
+PlotFileDataImpl::regionBox (int level, RealBox const& region) const noexcept
+{
+    const Box& domain = m_prob_domain[level];
+    IntVect lo = domain.smallEnd();
+    IntVect hi = domain.bigEnd();
+    for (int idim = 0; idim < m_spacedim; ++idim) {
+        const Real dx = m_cell_size[level][idim];
+        lo[idim] = static_cast<int>(std::floor((region.lo(idim)-m_prob_lo[idim])/dx));
+        hi[idim] = static_cast<int>(std::ceil((region.hi(idim)-m_prob_lo[idim])/dx)) - 1;
+        hi[idim] = std::max(hi[idim], lo[idim]);
+    }
+    return Box(lo,hi) & domain;
+}
+
+FArrayBox
+PlotFileDataImpl::getFab (int level, int gid) noexcept
+{
+    std::unique_ptr<FArrayBox> fab(m_vismf[level]->readFAB(gid, m_mf_name[level]));
+    return std::move(*fab);
+}
+
+Vector<int>
+PlotFileDataImpl::fileOrder (int level) const noexcept
+{
+    Vector<int> gids(m_ba[level].size());
+    std::iota(gids.begin(), gids.end(), 0);
+    if (m_vismf[level]) {
+        const VisMF& vismf = *m_vismf[level];
+        std::stable_sort(gids.begin(), gids.end(), [&] (int i, int j) {
+            const VisMF::FabOnDisk& fi = vismf.fabOnDisk(i);
+            const VisMF::FabOnDisk& fj = vismf.fabOnDisk(j);
+            return (fi.m_name < fj.m_name) || (fi.m_name == fj.m_name && fi.m_head < fj.m_head);
+        });
+    }
+    return gids;
+}
+
+Vector<Real>
+PlotFileDataImpl::maxAbs (int level, std::string const& varname) const noexcept
+{
+    Vector<Real> r;
+    auto it = std::find(std::begin(m_var_names), std::end(m_var_names), varname);
+    if (it == std::end(m_var_names)) {
+        amrex::Abort("PlotFileDataImpl::maxAbs: varname not found "+varname);
+    } else if (m_vismf[level]) {
+        const VisMF& vismf = *m_vismf[level];
+        const int icomp = std::distance(std::begin(m_var_names), it);
+        const int nfabs = m_ba[level].size();
+        if (nfabs > 0 && vismf.min(0, icomp) <= vismf.max(0, icomp)) {
+            r.resize(nfabs);
+            for (int gid = 0; gid < nfabs; ++gid) {
+                r[gid] = std::max(std::abs(vismf.min(gid, icomp)),
+                                  std::abs(vismf.max(gid, icomp)));
+            }
+        }
+    }
+    return r;
+}
+
 MultiFab
 PlotFileDataImpl::get (int level, std::string const& varname) noexcept
 {
@@ -0,0 +1,303 @@
+
+#include <AMReX_TArena.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_OpenMP.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+
+namespace amrex {
+
+namespace {
+    //! The header in front of each block.  It occupies Arena::align_size bytes.
+    struct BlockHeader
+    {
+        int cls;
+        unsigned int magic;
+    };
+
+    constexpr unsigned int tarena_magic = 0x7a4e4ac5u;
+    constexpr std::size_t header_size = Arena::align_size;
+    static_assert(sizeof(BlockHeader) <= header_size, "TArena: BlockHeader too big");
+
+    BlockHeader* get_header (void* p) noexcept
+    {
+        return reinterpret_cast<BlockHeader*>(static_cast<char*>(p) - header_size);
+    }
+}
+
+TArena::TArena (std::size_t max_block_size, std::size_t slab_size,
+                std::size_t hunk_size, ArenaInfo info)
+    : m_carena(hunk_size, info)
+{
+    arena_info = info;
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(isHostAccessible(),
+                                     "TArena requires host accessible memory");
+
+    m_max_block_size = Arena::align(std::max(max_block_size, Arena::align_size));
+    m_nclasses = sizeClass(m_max_block_size) + 1;
+    m_max_block_size = classSize(m_nclasses-1);
+    m_slab_size = slab_size;
+
+    m_batch.resize(m_nclasses);
+    for (int cls = 0; cls < m_nclasses; ++cls) {
+        const std::size_t stride = classSize(cls) + header_size;
+        const std::size_t nblocks = std::max(m_slab_size / stride, std::size_t(1));
+        m_batch[cls] = static_cast<int>(std::min(nblocks, std::size_t(64)));
+    }
+
+    const int nthreads = OpenMP::get_max_threads();
+    m_cache.resize(nthreads);
+    for (auto& c : m_cache) {
+        c = std::make_unique<ThreadCache>();
+        c->bins.resize(m_nclasses);
+    }
+
+    m_central.resize(m_nclasses);
+    for (auto& c : m_central) {
+        c = std::make_unique<CentralList>();
+    }
+}
+
+TArena::~TArena ()
+{
+    // All slabs and large blocks are released by m_carena's destructor.
+}
+
+int
+TArena::sizeClass (std::size_t nbytes) noexcept
+{
+    // Multiples of 16 bytes up to 128 bytes, then four classes per
+    // doubling, so that no more than 25% of a block is wasted.
+    if (nbytes <= 128) {
+        return static_cast<int>((nbytes+15)/16) - 1;
+    } else {
+        int k = 0;
+        for (std::size_t m = nbytes-1; m > 1; m >>= 1) { ++k; }
+        const std::size_t base = std::size_t(1) << k;
+        const std::size_t step = base >> 2;
+        const auto idx = static_cast<int>((nbytes - base + step - 1) / step);
+        return 8 + (k-7)*4 + (idx-1);
+    }
+}
+
+std::size_t
+TArena::classSize (int cls) noexcept
+{
+    if (cls < 8) {
+        return std::size_t(cls+1) * 16;
+    } else {
+        const int k = 7 + (cls-8)/4;
+        const int idx = (cls-8)%4 + 1;
+        const std::size_t base = std::size_t(1) << k;
+        return base + idx*(base >> 2);
+    }
+}
+
+void*
+TArena::alloc (std::size_t nbytes)
+{
+    nbytes = Arena::align(nbytes == 0 ? 1 : nbytes);
+
+    ThreadCache& tc = *m_cache[OpenMP::get_thread_num() % m_cache.size()];
+
+    if (nbytes > m_max_block_size)
+    {
+        void* p = static_cast<char*>(m_carena.alloc(nbytes+header_size)) + header_size;
+        BlockHeader* h = get_header(p);
+        h->cls = -1;
+        h->magic = tarena_magic;
+
+        std::lock_guard<std::mutex> lock(tc.mutex);
+        ++tc.stats.nallocs;
+        ++tc.stats.nlarge;
+        return p;
+    }
+
+    const int cls = sizeClass(nbytes);
+
+    std::lock_guard<std::mutex> lock(tc.mutex);
+
+    ++tc.stats.nallocs;
+
+    auto& bin = tc.bins[cls];
+    if (bin.empty()) {
+        refill(tc, cls);
+    } else {
+        ++tc.stats.ncache_hits;
+    }
+
+    void* p = bin.back();
+    bin.pop_back();
+    return p;
+}
+
+void
+TArena::free (void* p)
+{
+    if (p == nullptr) {
+        //
+        // Allow calls with NULL as allowed by C++ delete.
+        //
+        return;
+    }
+
+    BlockHeader* h = get_header(p);
+    if (h->magic != tarena_magic) {
+        amrex::Abort("TArena::free: unknown pointer");
+        return;
+    }
+
+    ThreadCache& tc = *m_cache[OpenMP::get_thread_num() % m_cache.size()];
+
+    const int cls = h->cls;
+    if (cls < 0)
+    {
+        h->magic = 0;
+        m_carena.free(h);
+
+        std::lock_guard<std::mutex> lock(tc.mutex);
+        ++tc.stats.nfrees;
+        return;
+    }
+
+    BL_ASSERT(cls < m_nclasses);
+
+    std::lock_guard<std::mutex> lock(tc.mutex);
+
+    ++tc.stats.nfrees;
+
+    auto& bin = tc.bins[cls];
+    bin.push_back(p);
+    //
+    // Do not let a thread that frees more than it allocates hoard blocks.
+    //
+    if (bin.size() > 2*static_cast<std::size_t>(m_batch[cls])) {
+        flush(tc, cls, m_batch[cls]);
+    }
+}
+
+void
+TArena::refill (ThreadCache& tc, int cls)
+{
+    CentralList& cl = *m_central[cls];
+    std::lock_guard<std::mutex> lock(cl.mutex);
+
+    if (cl.blocks.empty())
+    {
+        //
+        // Carve a new slab into blocks of this size class.
+        //
+        const std::size_t stride = classSize(cls) + header_size;
+        const std::size_t nblocks = std::max(m_slab_size / stride, std::size_t(1));
+        char* slab = static_cast<char*>(m_carena.alloc(nblocks*stride));
+        cl.blocks.reserve(nblocks);
+        for (std::size_t i = nblocks; i > 0; --i) {
+            char* p = slab + (i-1)*stride + header_size;
+            BlockHeader* h = get_header(p);
+            h->cls = cls;
+            h->magic = tarena_magic;
+            cl.blocks.push_back(p);
+        }
+        ++tc.stats.nslabs;
+    }
+
+    const auto n = std::min(cl.blocks.size(), static_cast<std::size_t>(m_batch[cls]));
+    auto& bin = tc.bins[cls];
+    bin.insert(bin.end(), cl.blocks.end()-n, cl.blocks.end());
+    cl.blocks.resize(cl.blocks.size()-n);
+
+    ++tc.stats.nrefills;
+}
+
+void
+TArena::flush (ThreadCache& tc, int cls, std::size_t nkeep)
+{
+    auto& bin = tc.bins[cls];
+    if (bin.size() <= nkeep) return;
+
+    CentralList& cl = *m_central[cls];
+    std::lock_guard<std::mutex> lock(cl.mutex);
+    cl.blocks.insert(cl.blocks.end(), bin.begin()+nkeep, bin.end());
+    bin.resize(nkeep);
+}
+
+std::size_t
+TArena::freeUnused ()
+{
+    for (auto& c : m_cache) {
+        std::lock_guard<std::mutex> lock(c->mutex);
+        for (int cls = 0; cls < m_nclasses; ++cls) {
+            flush(*c, cls, 0);
+        }
+    }
+    return m_carena.freeUnused();
+}
+
+std::size_t
+TArena::sizeOf (void* p) const noexcept
+{
+    if (p == nullptr) {
+        return 0;
+    } else {
+        BlockHeader* h = get_header(p);
+        if (h->magic != tarena_magic) {
+            return 0;
+        } else if (h->cls < 0) {
+            return m_carena.sizeOf(h) - header_size;
+        } else {
+            return classSize(h->cls);
+        }
+    }
+}
+
+TArena::Stats
+TArena::stats () const
+{
+    Stats r;
+    for (auto const& c : m_cache) {
+        std::lock_guard<std::mutex> lock(c->mutex);
+        r.nallocs     += c->stats.nallocs;
+        r.nfrees      += c->stats.nfrees;
+        r.ncache_hits += c->stats.ncache_hits;
+        r.nrefills    += c->stats.nrefills;
+        r.nslabs      += c->stats.nslabs;
+        r.nlarge      += c->stats.nlarge;
+    }
+    return r;
+}
+
+void
+TArena::PrintUsage (std::string const& name) const
+{
+    m_carena.PrintUsage(name);
+
+    Stats s = stats();
+    Long counts[] = {s.nallocs, s.nfrees, s.ncache_hits, s.nrefills, s.nslabs, s.nlarge};
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+    ParallelReduce::Sum<Long>(counts, 6, IOProc, ParallelDescriptor::Communicator());
+    const double hit_rate = (counts[0] > 0)
+        ? 100.*static_cast<double>(counts[2])/static_cast<double>(counts[0]) : 0.;
+    amrex::Print() << "[" << name << "] " << counts[0] << " allocs, "
+                   << counts[1] << " frees, " << hit_rate << "% from thread caches\n"
+                   << "[" << name << "] " << counts[3] << " refills, "
+                   << counts[4] << " slabs, " << counts[5] << " large allocs\n";
+}
+
+void
+TArena::PrintUsage (std::ostream& os, std::string const& name, std::string const& space) const
+{
+    m_carena.PrintUsage(os, name, space);
+
+    Stats s = stats();
+    const double hit_rate = (s.nallocs > 0)
+        ? 100.*static_cast<double>(s.ncache_hits)/static_cast<double>(s.nallocs) : 0.;
+    os << space << "[" << name << "]: " << s.nallocs << " allocs, "
+       << s.nfrees << " frees, " << hit_rate << "% from thread caches\n";
+    os << space << "[" << name << "]: " << s.nrefills << " refills, "
+       << s.nslabs << " slabs, " << s.nlarge << " large allocs\n";
+}
+
+}
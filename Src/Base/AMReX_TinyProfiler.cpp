@@ -1,5 +1,5 @@
 // We only support BL_PROFILE, BL_PROFILE_VAR, BL_PROFILE_VAR_STOP, BL_PROFILE_VAR_START,
-// BL_PROFILE_VAR_NS, and BL_PROFILE_REGION.
+// BL_PROFILE_VAR_NS, BL_PROFILE_REGION, and BL_PROFILE_ID.
 
 #include <AMReX_TinyProfiler.H>
 #include <AMReX_ParallelDescriptor.H>
@@ -22,8 +22,11 @@
 
 #include <algorithm>
 #include <cmath>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <memory>
+#include <mutex>
 #include <set>
 
 namespace amrex {
@@ -39,6 +42,74 @@ int TinyProfiler::verbose = 0;
 namespace {
     std::set<std::string> improperly_nested_timers;
     static constexpr char mainregion[] = "main";
+    static constexpr char idregion[] = "BL_PROFILE_ID";
+
+    // Timers by ID
+    struct IDStats
+    {
+        int  depth = 0;
+        Long n = 0L;
+        double dtin = 0.0;
+        double dtex = 0.0;
+    };
+
+    struct IDFrame
+    {
+        double t0;      // start time
+        double dtchild; // accumulated dt of children
+        int id;
+    };
+
+    struct TraceEvent
+    {
+        double t0;
+        double t1;
+        int id;
+    };
+
+    // Only the owning thread writes to this.
+    struct ThreadData
+    {
+        int tid = 0;
+        std::vector<IDStats> stats;     // indexed by ID
+        std::vector<IDFrame> stack;
+        std::vector<TraceEvent> trace;  // ring buffer
+        Long ntrace = 0;
+        std::set<int> improper;         // IDs of timers not properly nested
+    };
+
+    std::mutex id_mutex;
+    std::map<std::string,int> id_map;
+    std::vector<std::string> id_names;
+    std::vector<std::unique_ptr<ThreadData> > thread_data;
+    thread_local ThreadData* this_thread_data = nullptr;
+
+    std::string trace_file;
+    int trace_buffer_size = 100000;
+
+    ThreadData* get_thread_data ()
+    {
+        if (this_thread_data == nullptr) {
+            auto td = std::make_unique<ThreadData>();
+            td->stack.reserve(64);
+            if (!trace_file.empty()) {
+                td->trace.resize(trace_buffer_size);
+            }
+            std::lock_guard<std::mutex> lock(id_mutex);
+            td->tid = static_cast<int>(thread_data.size());
+            this_thread_data = td.get();
+            thread_data.push_back(std::move(td));
+        }
+        return this_thread_data;
+    }
+
+    void add_trace_event (ThreadData* td, int id, double t0, double t1)
+    {
+        if (!td->trace.empty()) {
+            td->trace[td->ntrace % static_cast<Long>(td->trace.size())] = TraceEvent{t0, t1, id};
+            ++(td->ntrace);
+        }
+    }
 }
 
 TinyProfiler::TinyProfiler (std::string funcname) noexcept
@@ -112,6 +183,11 @@ TinyProfiler::start () noexcept
             stats.push_back(&st);
         }
 
+        // The name is interned once, when it is first timed in the main region.
+        if (!uCUPTI && !trace_file.empty() && stats.front()->id < 0) {
+            stats.front()->id = InternName(fname.c_str());
+        }
+
         if (verbose) {
             ++n_print_tabs;
             std::string whitespace;
@@ -179,6 +255,10 @@ TinyProfiler::stop () noexcept
                 }
             }
 
+            if (!uCUPTI && stats.front()->id >= 0) {
+                add_trace_event(get_thread_data(), stats.front()->id, std::get<0>(tt), t);
+            }
+
             ttstack.pop_back();
             if (!ttstack.empty()) {
                 std::tuple<double,double,std::string*>& parent = ttstack.back();
@@ -303,6 +383,8 @@ TinyProfiler::Initialize () noexcept
         pp.queryAdd("device_synchronize_around_region", device_synchronize_around_region);
         pp.queryAdd("verbose", verbose);
         pp.queryAdd("v", verbose);
+        pp.queryAdd("trace_file", trace_file);
+        pp.queryAdd("trace_buffer_size", trace_buffer_size);
     }
 }
 
@@ -322,6 +404,11 @@ TinyProfiler::Finalize (bool bFlushing) noexcept
 
     // make a local copy so that any functions call after this will not be recorded in the local copy.
     auto lstatsmap = statsmap;
+    AddIDStats(lstatsmap);
+
+    if (!trace_file.empty()) {
+        WriteTrace();
+    }
 
     bool properly_nested = improperly_nested_timers.size() == 0;
     ParallelDescriptor::ReduceBoolAnd(properly_nested);
@@ -591,6 +678,158 @@ TinyProfiler::PrintStats (std::map<std::string,Stats>& regstats, double dt_max)
     }
 }
 
+int
+TinyProfiler::InternName (const char* name)
+{
+    std::lock_guard<std::mutex> lock(id_mutex);
+    auto r = id_map.emplace(name, static_cast<int>(id_names.size()));
+    if (r.second) {
+        id_names.emplace_back(name);
+    }
+    return r.first->second;
+}
+
+void
+TinyProfiler::StartID (int id) noexcept
+{
+    ThreadData* td = get_thread_data();
+    if (id >= static_cast<int>(td->stats.size())) {
+        td->stats.resize(id+1);
+    }
+    ++(td->stats[id].depth);
+    td->stack.push_back(IDFrame{amrex::second(), 0.0, id});
+}
+
+void
+TinyProfiler::StopID (int id) noexcept
+{
+    double t = amrex::second();
+    ThreadData* td = get_thread_data();
+
+    // Find the start of this timer.  The timers started after it and not
+    // yet stopped are dropped.
+    auto it = std::find_if(td->stack.rbegin(), td->stack.rend(),
+                           [=] (IDFrame const& f) { return f.id == id; });
+    if (it == td->stack.rend()) {
+        td->improper.insert(id);
+        return;
+    }
+    if (it != td->stack.rbegin()) {
+        td->improper.insert(id);
+        while (td->stack.back().id != id) {
+            td->improper.insert(td->stack.back().id);
+            --(td->stats[td->stack.back().id].depth);
+            td->stack.pop_back();
+        }
+    }
+
+    const IDFrame tt = td->stack.back();
+    td->stack.pop_back();
+    double dtin = t - tt.t0;
+    double dtex = dtin - tt.dtchild;
+    if (!td->stack.empty()) {
+        td->stack.back().dtchild += dtin;
+    }
+
+    IDStats& st = td->stats[id];
+    --(st.depth);
+    ++(st.n);
+    if (st.depth == 0) {
+        st.dtin += dtin;
+    }
+    st.dtex += dtex;
+
+    add_trace_event(td, id, tt.t0, t);
+}
+
+// Adds the timers by ID in their own region, because their time is not
+// subtracted from the exclusive time of the enclosing string timers.  The
+// numbers of calls are summed over threads and the times are the maximum
+// over threads.
+void
+TinyProfiler::AddIDStats (std::map<std::string,std::map<std::string,Stats> >& regions)
+{
+    std::lock_guard<std::mutex> lock(id_mutex);
+    for (int id = 0; id < static_cast<int>(id_names.size()); ++id) {
+        Long n = 0;
+        double dtin = 0.0, dtex = 0.0;
+        for (auto const& td : thread_data) {
+            if (id < static_cast<int>(td->stats.size())) {
+                n += td->stats[id].n;
+                dtin = std::max(dtin, td->stats[id].dtin);
+                dtex = std::max(dtex, td->stats[id].dtex);
+            }
+        }
+        if (n > 0) {
+            Stats& st = regions[idregion][id_names[id]];
+            st.n += n;
+            st.dtin += dtin;
+            st.dtex += dtex;
+        }
+    }
+    for (auto const& td : thread_data) {
+        for (int id : td->improper) {
+            if (id >= 0 && id < static_cast<int>(id_names.size())) {
+                improperly_nested_timers.insert(id_names[id]);
+            }
+        }
+    }
+}
+
+namespace {
+    std::string json_escape (std::string const& s)
+    {
+        std::string r;
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                r += '\\';
+                r += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                r += ' ';
+            } else {
+                r += c;
+            }
+        }
+        return r;
+    }
+}
+
+// Each process writes the events in its trace buffers to
+// trace_file.<rank>.json in the Chrome trace event format, which can be
+// viewed with chrome://tracing or Perfetto.
+void
+TinyProfiler::WriteTrace ()
+{
+    std::lock_guard<std::mutex> lock(id_mutex);
+    const int myproc = ParallelDescriptor::MyProc();
+    std::ofstream ofs(trace_file + "." + std::to_string(myproc) + ".json");
+    if (!ofs) {
+        amrex::Print() << "TinyProfiler: failed to open trace file " << trace_file << "\n";
+        return;
+    }
+    ofs << std::setprecision(15);
+    ofs << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    bool first = true;
+    for (auto const& td : thread_data) {
+        const auto nbuf = static_cast<Long>(td->trace.size());
+        for (Long i = std::max(Long(0), td->ntrace-nbuf); i < td->ntrace; ++i) {
+            TraceEvent const& e = td->trace[i % nbuf];
+            if (!first) { ofs << ",\n"; }
+            first = false;
+            ofs << "{\"name\": \"" << json_escape(id_names[e.id])
+                << "\", \"ph\": \"X\", \"ts\": " << (e.t0-t_init)*1.e6
+                << ", \"dur\": " << (e.t1-e.t0)*1.e6
+                << ", \"pid\": " << myproc << ", \"tid\": " << td->tid << "}";
+        }
+        if (td->ntrace > nbuf) {
+            amrex::AllPrint() << "TinyProfiler: rank " << myproc << " thread " << td->tid
+                              << " dropped the oldest " << td->ntrace-nbuf
+                              << " trace events.  Increase tiny_profiler.trace_buffer_size.\n";
+        }
+    }
+    ofs << "\n]}\n";
+}
+
 void
 TinyProfiler::StartRegion (std::string regname) noexcept
 {
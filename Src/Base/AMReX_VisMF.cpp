@@ -1,13 +1,21 @@
 
 #include <AMReX_FabArrayUtility.H>
+#include <AMReX_FabCompress.H>
 #include <AMReX_FPC.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
 #include <AMReX_VisMF.H>
 
 #include <cerrno>
+#include <condition_variable>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <tuple>
 
 namespace amrex {
 
@@ -28,6 +36,10 @@ bool VisMF::usePersistentIFStreams(false);
 bool VisMF::useSynchronousReads(false);
 bool VisMF::useDynamicSetSelection(true);
 bool VisMF::allowSparseWrites(true);
+Long VisMF::compressionChunkSize(1024*1024);
+bool VisMF::useThreadedReads(false);
+int VisMF::nReadThreads(2);
+Long VisMF::coalescedReadSize(64*1024*1024);
 
 Long VisMFBuffer::ioBufferSize(VisMF::IO_Buffer_Size);
 
@@ -76,6 +88,11 @@ VisMF::Initialize ()
     pp.queryAdd("usedynamicsetselection", useDynamicSetSelection);
     pp.queryAdd("iobuffersize", ioBufferSize);
     pp.queryAdd("allowsparsewrites", allowSparseWrites);
+    pp.queryAdd("compressionchunksize", compressionChunkSize);
+    pp.queryAdd("usethreadedreads", useThreadedReads);
+    pp.queryAdd("nreadthreads", nReadThreads);
+    nReadThreads = std::max(nReadThreads, 1);
+    pp.queryAdd("coalescedreadsize", coalescedReadSize);
 
     initialized = true;
 }
@@ -280,7 +297,9 @@ operator<< (std::ostream        &os,
       os << hd.m_max      << '\n';
     }
 
-    if(hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1) {
+    if(hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1 ||
+       hd.m_vers == VisMF::Header::NoFabHeaderCompressed_v1)
+    {
       BL_ASSERT(hd.m_famin.size() == hd.m_ncomp);
       BL_ASSERT(hd.m_famin.size() == hd.m_famax.size());
       for(int i(0); i < hd.m_famin.size(); ++i) {
@@ -293,9 +312,7 @@ operator<< (std::ostream        &os,
       os << '\n';
     }
 
-    if(hd.m_vers == VisMF::Header::NoFabHeader_v1       ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1)
+    if(VisMF::NoFabHeader(hd))
     {
       if(FArrayBox::getFormat() == FABio::FAB_NATIVE) {
         os << FPC::NativeRealDescriptor() << '\n';
@@ -306,6 +323,22 @@ operator<< (std::ostream        &os,
       }
     }
 
+    if(hd.m_vers == VisMF::Header::NoFabHeaderCompressed_v1) {
+      // ---- the points per chunk, then for each fab the number of chunks and their sizes
+      os << hd.m_chunk_points << '\n';
+      for(int i(0); i < hd.m_ba.size(); ++i) {
+        if(i < hd.m_chunk_size.size()) {
+          os << hd.m_chunk_size[i].size();
+          for(Long csize : hd.m_chunk_size[i]) {
+            os << ' ' << csize;
+          }
+        } else {
+          os << 0;
+        }
+        os << '\n';
+      }
+    }
+
     os.flags(oflags);
     os.precision(oldPrec);
 
@@ -366,7 +399,9 @@ operator>> (std::istream  &is,
       BL_ASSERT(hd.m_ba.size() == hd.m_max.size());
     }
 
-    if(hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1) {
+    if(hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1 ||
+       hd.m_vers == VisMF::Header::NoFabHeaderCompressed_v1)
+    {
       char ch;
       hd.m_famin.resize(hd.m_ncomp);
       hd.m_famax.resize(hd.m_ncomp);
@@ -383,13 +418,25 @@ operator>> (std::istream  &is,
         }
       }
     }
-    if(hd.m_vers == VisMF::Header::NoFabHeader_v1       ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1)
+    if(VisMF::NoFabHeader(hd))
     {
       is >> hd.m_writtenRD;
     }
 
+    if(hd.m_vers == VisMF::Header::NoFabHeaderCompressed_v1) {
+      is >> hd.m_chunk_points;
+      hd.m_chunk_size.resize(hd.m_ba.size());
+      for(int i(0); i < hd.m_chunk_size.size(); ++i) {
+        Long nChunks;
+        is >> nChunks;
+        BL_ASSERT(nChunks >= 0);
+        hd.m_chunk_size[i].resize(nChunks);
+        for(Long j(0); j < nChunks; ++j) {
+          is >> hd.m_chunk_size[i][j];
+        }
+      }
+    }
+
 
     if( ! is.good()) {
         amrex::Error("Read of VisMF::Header failed");
@@ -453,6 +500,13 @@ VisMF::boxArray () const
     return m_hdr.m_ba;
 }
 
+const VisMF::FabOnDisk&
+VisMF::fabOnDisk (int fabIndex) const
+{
+    BL_ASSERT(0 <= fabIndex && fabIndex < m_hdr.m_fod.size());
+    return m_hdr.m_fod[fabIndex];
+}
+
 Real
 VisMF::min (int fabIndex, int nc) const
 {
@@ -660,7 +714,7 @@ VisMF::Header::Header (const FabArray<FArrayBox>& mf,
     bool run_on_device = Gpu::inLaunchRegion()
         && (mf.arena()->isManaged() || mf.arena()->isDevice());
 
-    if(version == NoFabHeaderFAMinMax_v1) {
+    if(version == NoFabHeaderFAMinMax_v1 || version == NoFabHeaderCompressed_v1) {
       // ---- calculate FabArray min max values only
       m_min.clear();
       m_max.clear();
@@ -924,11 +978,6 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
     BL_ASSERT(mf_name[mf_name.length() - 1] != '/');
     BL_ASSERT(currentVersion != VisMF::Header::Undefined_v1);
 
-    // ---- add stream retry
-    // ---- add stream buffer (to nfiles)
-    auto whichRD = FArrayBox::getDataDescriptor();
-    bool doConvert(*whichRD != FPC::NativeRealDescriptor());
-
     if(set_ghost && mf.nGrowVect() != 0) {
         FabArray<FArrayBox>* the_mf = const_cast<FabArray<FArrayBox>*>(&mf);
 
@@ -951,6 +1000,29 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
         }
     }
 
+    bool calcMinMax(false);
+    VisMF::Header hdr(mf, how, currentVersion, calcMinMax);
+
+    int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
+    Long bytesWritten = VisMF::WriteFABs(mf, mf_name, hdr, coordinatorProc);
+
+    bytesWritten += VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
+
+    return bytesWritten;
+}
+
+
+Long
+VisMF::WriteFABs (const FabArray<FArrayBox> &mf,
+                  const std::string &mf_name,
+                  VisMF::Header &hdr,
+                  int &coordinatorProc)
+{
+    // ---- add stream retry
+    // ---- add stream buffer (to nfiles)
+    auto whichRD = FArrayBox::getDataDescriptor();
+    bool doConvert(*whichRD != FPC::NativeRealDescriptor());
+
     // ---- check if mf has sparse data
     bool useSparseFPP(false);
     const Vector<int> &pmap = mf.DistributionMap().ProcessorMap();
@@ -967,10 +1039,8 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
       }
     }
 
-    int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
+    coordinatorProc = ParallelDescriptor::IOProcessorNumber();
     Long bytesWritten(0);
-    bool calcMinMax(false);
-    VisMF::Header hdr(mf, how, currentVersion, calcMinMax);
 
     std::string filePrefix(mf_name + FabFileSuffix);
 
@@ -978,12 +1048,41 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
 
     bool oldHeader(currentVersion == VisMF::Header::Version_v1);
 
+    // ---- compress the fabs before waiting for our turn to write
+    bool compressed(currentVersion == VisMF::Header::NoFabHeaderCompressed_v1);
+    Vector<Vector<char> > compressedData;
+    Vector<Long> localChunkSizes;
+    if(compressed) {
+        hdr.m_chunk_points = std::max(compressionChunkSize / whichRD->numBytes(), Long(1));
+        const int nLocalFabs(mf.local_size());
+        Vector<Vector<Long> > chunkSizes(nLocalFabs);
+        compressedData.resize(nLocalFabs);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for(int li = 0; li < nLocalFabs; ++li) {
+            VisMF::compressFAB(mf[mf.IndexArray()[li]], *whichRD, hdr.m_chunk_points,
+                               compressedData[li], chunkSizes[li]);
+        }
+        for(auto const& cs : chunkSizes) {
+            localChunkSizes.insert(localChunkSizes.end(), cs.begin(), cs.end());
+        }
+    }
+
     if(useSparseFPP) {
         nfi.SetSparseFPP(procsWithDataVector);
     } else if(useDynamicSetSelection) {
         nfi.SetDynamic();
     }
     for( ; nfi.ReadyToWrite(); ++nfi) {
+        if(compressed) {
+            for(auto const& cdata : compressedData) {
+                nfi.Stream().write(cdata.data(), cdata.size());
+                bytesWritten += cdata.size();
+            }
+            nfi.Stream().flush();
+            continue;
+        }
         // ---- find the total number of bytes including fab headers if needed
         const FABio &fio = FArrayBox::getFABio();
         int whichRDBytes(whichRD->numBytes()), nFABs(0);
@@ -1101,15 +1200,350 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
         hdr.CalculateMinMax(mf, coordinatorProc);
     }
 
+    if(compressed) {
+        VisMF::GatherChunkSizes(mf, hdr, localChunkSizes, coordinatorProc);
+    }
+
     VisMF::FindOffsets(mf, filePrefix, hdr, currentVersion, nfi,
                        ParallelDescriptor::Communicator());
 
-    bytesWritten += VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
+    return bytesWritten;
+}
+
+
+namespace {
+
+    constexpr std::uint64_t hash_prime1 = 11400714785074694791ULL;
+    constexpr std::uint64_t hash_prime2 = 14029467366897019727ULL;
+    constexpr std::uint64_t hash_prime3 =  1609587929392839161ULL;
+    constexpr std::uint64_t hash_prime4 =  9650029242287828579ULL;
+    constexpr std::uint64_t hash_prime5 =  2870177450012600261ULL;
+
+    std::uint64_t hashRotl (std::uint64_t x, int r) noexcept
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    std::uint64_t hashRound (std::uint64_t acc, std::uint64_t word) noexcept
+    {
+        acc += word * hash_prime2;
+        return hashRotl(acc, 31) * hash_prime1;
+    }
+
+    // ---- a 64 bit hash built from the rounds of xxHash64, with four lanes
+    std::uint64_t hashBytes (const unsigned char *p, Long nbytes) noexcept
+    {
+        std::uint64_t acc[4] = { hash_prime1 + hash_prime2, hash_prime2, 0, 0 - hash_prime1 };
+        Long i(0);
+        for( ; i + 32 <= nbytes; i += 32) {
+            for(int lane(0); lane < 4; ++lane) {
+                std::uint64_t word;
+                std::memcpy(&word, p + i + 8*lane, sizeof(word));
+                acc[lane] = hashRound(acc[lane], word);
+            }
+        }
+        std::uint64_t h = hashRotl(acc[0], 1) + hashRotl(acc[1], 7)
+                        + hashRotl(acc[2], 12) + hashRotl(acc[3], 18);
+        h += static_cast<std::uint64_t>(nbytes);
+        for( ; i + 8 <= nbytes; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, p + i, sizeof(word));
+            h = hashRotl(h ^ hashRound(0, word), 27) * hash_prime1 + hash_prime4;
+        }
+        for( ; i < nbytes; ++i) {
+            h = hashRotl(h ^ (p[i] * hash_prime5), 11) * hash_prime1;
+        }
+        h ^= h >> 33;
+        h *= hash_prime2;
+        h ^= h >> 29;
+        h *= hash_prime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    // ---- the components of a path with "." removed and ".." resolved where possible
+    Vector<std::string> pathComponents (const std::string &path)
+    {
+        Vector<std::string> comps;
+        std::string::size_type pos(0);
+        while(pos <= path.size()) {
+            std::string::size_type next(path.find('/', pos));
+            if(next == std::string::npos) {
+                next = path.size();
+            }
+            std::string comp(path.substr(pos, next - pos));
+            if(comp == "..") {
+                if( ! comps.empty() && comps.back() != "..") {
+                    comps.pop_back();
+                } else {
+                    comps.push_back(comp);
+                }
+            } else if( ! comp.empty() && comp != ".") {
+                comps.push_back(comp);
+            }
+            pos = next + 1;
+        }
+        return comps;
+    }
+
+    std::string normalizePath (const std::string &path)
+    {
+        std::string result;
+        for(const std::string &comp : pathComponents(path)) {
+            if( ! result.empty()) {
+                result += '/';
+            }
+            result += comp;
+        }
+        return result;
+    }
+
+    // ---- the path of to_dir relative to from_dir, false if it cannot be found
+    bool relativePath (const std::string &from_dir, const std::string &to_dir, std::string &rel)
+    {
+        const bool fromAbsolute( ! from_dir.empty() && from_dir[0] == '/');
+        const bool toAbsolute( ! to_dir.empty() && to_dir[0] == '/');
+        if(fromAbsolute != toAbsolute) {
+            return false;
+        }
+        const Vector<std::string> from(pathComponents(from_dir));
+        const Vector<std::string> to(pathComponents(to_dir));
+        Long common(0);
+        while(common < from.size() && common < to.size() && from[common] == to[common]) {
+            ++common;
+        }
+        rel.clear();
+        for(Long i(common); i < from.size(); ++i) {
+            if(from[i] == "..") {
+                return false;
+            }
+            rel += "../";
+        }
+        for(Long i(common); i < to.size(); ++i) {
+            rel += to[i] + '/';
+        }
+        return true;
+    }
+}
+
+
+void
+VisMF::MoveHeader (VisMF::Header &hdr, int fromProc, int toProc)
+{
+    const int myProc(ParallelDescriptor::MyProc());
+    Vector<char> hdrChars;
+    if(myProc == fromProc) {
+        std::ostringstream hss;
+        hss << hdr;
+        const std::string hdrString(hss.str());
+        hdrChars.assign(hdrString.begin(), hdrString.end());
+    }
+    amrex::BroadcastArray(hdrChars, myProc, fromProc, ParallelDescriptor::Communicator());
+    if(myProc == toProc) {
+        std::istringstream hss(std::string(hdrChars.begin(), hdrChars.end()));
+        hss >> hdr;
+    }
+}
+
+
+std::uint64_t
+VisMF::HashFAB (const FArrayBox &fab)
+{
+    Real const* fabdata = fab.dataPtr();
+#ifdef AMREX_USE_GPU
+    std::unique_ptr<FArrayBox> hostfab;
+    if (fab.arena()->isManaged() || fab.arena()->isDevice()) {
+        hostfab = std::make_unique<FArrayBox>(fab.box(), fab.nComp(), The_Pinned_Arena());
+        Gpu::dtoh_memcpy_async(hostfab->dataPtr(), fab.dataPtr(), fab.size()*sizeof(Real));
+        Gpu::streamSynchronize();
+        fabdata = hostfab->dataPtr();
+    }
+#endif
+    return hashBytes(reinterpret_cast<const unsigned char *>(fabdata),
+                     fab.box().numPts() * fab.nComp() * sizeof(Real));
+}
+
+
+void
+VisMF::IncrementalInfo::clear ()
+{
+    *this = IncrementalInfo();
+}
+
+
+Long
+VisMF::WriteIncremental (const FabArray<FArrayBox> &mf,
+                         const std::string &mf_name,
+                         const std::string &prev_name,
+                         VisMF::IncrementalInfo &info,
+                         VisMF::How how)
+{
+    BL_PROFILE("VisMF::WriteIncremental()");
+    BL_ASSERT(mf_name[mf_name.length() - 1] != '/');
+    BL_ASSERT(currentVersion != VisMF::Header::Undefined_v1);
+
+    const int myProc(ParallelDescriptor::MyProc());
+    const int ioProc(ParallelDescriptor::IOProcessorNumber());
+    const int nFabs(mf.size());
+    auto whichRD = FArrayBox::getDataDescriptor();
+    const bool compressed(currentVersion == VisMF::Header::NoFabHeaderCompressed_v1);
+    const Long chunkPoints(compressed ? std::max(compressionChunkSize / whichRD->numBytes(), Long(1))
+                                      : Long(0));
+
+    // ---- the previous data can only be used if the layout and format are the same
+    std::string prevDir;
+    const bool incremental( ! prev_name.empty() &&
+                           info.m_vers == currentVersion &&
+                           info.m_ba == mf.boxArray() &&
+                           info.m_dm == mf.DistributionMap() &&
+                           info.m_ncomp == mf.nComp() &&
+                           info.m_ngrow == mf.nGrowVect() &&
+                           info.m_writtenRD == *whichRD &&
+                           info.m_chunk_points == chunkPoints &&
+                           FArrayBox::getFormat() != FABio::FAB_ASCII &&
+                           FArrayBox::getFormat() != FABio::FAB_8BIT &&
+                           relativePath(VisMF::DirName(mf_name), VisMF::DirName(prev_name), prevDir));
+
+    std::map<int, std::uint64_t> fabHash;
+    Vector<int> changed(nFabs, incremental ? 0 : 1);
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const int idx(mfi.index());
+        const std::uint64_t h(VisMF::HashFAB(mf[mfi]));
+        fabHash[idx] = h;
+        if(incremental) {
+            auto hIter = info.m_hash.find(idx);
+            if(hIter == info.m_hash.end() || hIter->second != h) {
+                changed[idx] = 1;
+            }
+        }
+    }
+    if(incremental) {
+        ParallelDescriptor::ReduceIntMax(changed.dataPtr(), nFabs);
+    }
+
+    bool calcMinMax(false);
+    VisMF::Header hdr(mf, how, currentVersion, calcMinMax);
+    Long bytesWritten(0);
+
+    if( ! incremental) {
+        int coordinatorProc(ioProc);
+        bytesWritten += VisMF::WriteFABs(mf, mf_name, hdr, coordinatorProc);
+        if(coordinatorProc != ioProc) {    // ---- the header is needed on ioProc
+            VisMF::MoveHeader(hdr, coordinatorProc, ioProc);
+        }
+    } else {
+        // ---- write the changed fabs as a FabArray that aliases their data
+        BoxList changedBoxes(mf.boxArray().ixType());
+        Vector<int> changedPMap;
+        Vector<int> changedIndex(nFabs, -1);
+        for(int i(0); i < nFabs; ++i) {
+            if(changed[i]) {
+                changedIndex[i] = changedPMap.size();
+                changedBoxes.push_back(mf.boxArray()[i]);
+                changedPMap.push_back(mf.DistributionMap()[i]);
+            }
+        }
+
+        Vector<VisMF::FabOnDisk> changedFod;
+        Vector<Vector<Long> > changedChunkSize;
+        if( ! changedPMap.empty()) {
+            BoxArray changedBA(std::move(changedBoxes));
+            DistributionMapping changedDM(std::move(changedPMap));
+            FabArray<FArrayBox> changedMF(changedBA, changedDM, mf.nComp(), mf.nGrowVect(),
+                                          MFInfo().SetAlloc(false));
+            for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                const int idx(mfi.index());
+                if(changed[idx]) {
+                    changedMF.setFab(changedIndex[idx],
+                                     FArrayBox(mf[mfi].box(), mf.nComp(), mf[mfi].dataPtr()));
+                }
+            }
+
+            VisMF::Header cHdr(changedMF, how, currentVersion, calcMinMax);
+            int coordinatorProc(ioProc);
+            bytesWritten += VisMF::WriteFABs(changedMF, mf_name, cHdr, coordinatorProc);
+
+            if(coordinatorProc != ioProc) {
+                VisMF::MoveHeader(cHdr, coordinatorProc, ioProc);
+            }
+            if(myProc == ioProc) {
+                changedFod = std::move(cHdr.m_fod);
+                changedChunkSize = std::move(cHdr.m_chunk_size);
+            }
+        }
+
+        if(hdr.m_vers == VisMF::Header::Version_v1 ||
+           hdr.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+        {
+            hdr.CalculateMinMax(mf, ioProc);
+        }
+
+        if(myProc == ioProc) {
+            if(compressed) {
+                hdr.m_chunk_points = chunkPoints;
+                hdr.m_chunk_size.resize(nFabs);
+            }
+            for(int i(0); i < nFabs; ++i) {
+                if(changed[i]) {
+                    hdr.m_fod[i] = changedFod[changedIndex[i]];
+                    if(compressed) {
+                        hdr.m_chunk_size[i] = changedChunkSize[changedIndex[i]];
+                    }
+                } else {
+                    hdr.m_fod[i].m_name = normalizePath(prevDir + info.m_fod[i].m_name);
+                    hdr.m_fod[i].m_head = info.m_fod[i].m_head;
+                    if(compressed) {
+                        hdr.m_chunk_size[i] = info.m_chunk_size[i];
+                    }
+                }
+            }
+        }
+    }
+
+    bytesWritten += VisMF::WriteHeader(mf_name, hdr, ioProc);
+
+    // ---- remember this write for the next one
+    info.m_ba           = mf.boxArray();
+    info.m_dm           = mf.DistributionMap();
+    info.m_ncomp        = mf.nComp();
+    info.m_ngrow        = mf.nGrowVect();
+    info.m_vers         = currentVersion;
+    info.m_writtenRD    = *whichRD;
+    info.m_chunk_points = chunkPoints;
+    info.m_hash         = std::move(fabHash);
+    if(myProc == ioProc) {
+        info.m_fod        = hdr.m_fod;
+        info.m_chunk_size = hdr.m_chunk_size;
+    }
 
     return bytesWritten;
 }
 
 
+void
+VisMF::ReferencedDirectories (const VisMF::IncrementalInfo &info,
+                              const std::string &name,
+                              std::set<std::string> &dirs)
+{
+    const std::string nameDir(VisMF::DirName(name));
+    for(const FabOnDisk &fod : info.m_fod) {
+        const Vector<std::string> comps(pathComponents(nameDir + fod.m_name));
+        if(comps.empty() || comps[0] != "..") {
+            continue;
+        }
+        // ---- everything up to the first component outside of root
+        std::string dir;
+        for(const std::string &comp : comps) {
+            dir += comp;
+            if(comp != "..") {
+                break;
+            }
+            dir += '/';
+        }
+        dirs.insert(dir);
+    }
+}
+
 Long
 VisMF::WriteOnlyHeader (const FabArray<FArrayBox> & mf,
                         const std::string         & mf_name,
@@ -1291,8 +1725,14 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
               for(int i(0); i < index.size(); ++i) {
                  hdr.m_fod[index[i]].m_name = whichFileName;
                  hdr.m_fod[index[i]].m_head = currentOffset[whichFileNumber];
-                 currentOffset[whichFileNumber] += mf.fabbox(index[i]).numPts() * nComps * whichRDBytes
-                                                   + fabHeaderBytes[index[i]];
+                 if(hdr.m_vers == VisMF::Header::NoFabHeaderCompressed_v1) {
+                   const Vector<Long> &chunkSize = hdr.m_chunk_size[index[i]];
+                   currentOffset[whichFileNumber] += std::accumulate(chunkSize.begin(),
+                                                                     chunkSize.end(), Long(0));
+                 } else {
+                   currentOffset[whichFileNumber] += mf.fabbox(index[i]).numPts() * nComps * whichRDBytes
+                                                     + fabHeaderBytes[index[i]];
+                 }
               }
             }
           }
@@ -1302,6 +1742,341 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
 }
 
 
+void
+VisMF::compressFAB (const FArrayBox &fab, const RealDescriptor &rd, Long chunkPoints,
+                    Vector<char> &cdata, Vector<Long> &chunkSizes)
+{
+    Real const* fabdata = fab.dataPtr();
+#ifdef AMREX_USE_GPU
+    std::unique_ptr<FArrayBox> hostfab;
+    if (fab.arena()->isManaged() || fab.arena()->isDevice()) {
+        hostfab = std::make_unique<FArrayBox>(fab.box(), fab.nComp(), The_Pinned_Arena());
+        Gpu::dtoh_memcpy_async(hostfab->dataPtr(), fab.dataPtr(), fab.size()*sizeof(Real));
+        Gpu::streamSynchronize();
+        fabdata = hostfab->dataPtr();
+    }
+#endif
+    const bool doConvert(rd != FPC::NativeRealDescriptor());
+    const int wordSize(rd.numBytes());
+    const Long npts(fab.box().numPts());
+    Vector<char> convertedData;
+
+    // ---- each component is split into chunks so that it can be read on its own
+    for(int n(0); n < fab.nComp(); ++n) {
+        for(Long ipt(0); ipt < npts; ipt += chunkPoints) {
+            const Long nItems(std::min(chunkPoints, npts - ipt));
+            Real const* chunkData = fabdata + n*npts + ipt;
+            const char *src = reinterpret_cast<const char *>(chunkData);
+            if(doConvert) {
+                convertedData.resize(nItems * wordSize);
+                RealDescriptor::convertFromNativeFormat(static_cast<void *> (convertedData.data()),
+                                                        nItems, chunkData, rd);
+                src = convertedData.data();
+            }
+            chunkSizes.push_back(FabCompress::compress(src, nItems * wordSize, wordSize, cdata));
+        }
+    }
+}
+
+
+void
+VisMF::GatherChunkSizes (const FabArray<FArrayBox> &mf, VisMF::Header &hdr,
+                         const Vector<Long> &localChunkSizes, int procToWrite)
+{
+    const int myProc(ParallelDescriptor::MyProc());
+    const int nProcs(ParallelDescriptor::NProcs());
+    const Vector<int> &pmap = mf.DistributionMap().ProcessorMap();
+
+    Vector<int> nChunks(mf.size());
+    std::vector<int> nmtags(nProcs,0);
+    std::vector<int> offset(nProcs,0);
+
+    for(int i(0), N(mf.size()); i < N; ++i) {
+        const Long npts(mf.fabbox(i).numPts());
+        nChunks[i] = static_cast<int>(mf.nComp() * ((npts + hdr.m_chunk_points - 1) / hdr.m_chunk_points));
+        nmtags[pmap[i]] += nChunks[i];
+    }
+
+    for(int i(1), N(offset.size()); i < N; ++i) {
+        offset[i] = offset[i-1] + nmtags[i-1];
+    }
+
+    BL_ASSERT(static_cast<int>(localChunkSizes.size()) == nmtags[myProc]);
+
+    // ---- can't let the buffers be empty as dataPtr() will fail
+    Vector<Long> senddata(localChunkSizes);
+    if(senddata.empty()) {
+        senddata.resize(1);
+    }
+
+    Vector<Long> recvdata(1);
+    if(myProc == procToWrite) {
+        recvdata.resize(std::max(offset[nProcs-1] + nmtags[nProcs-1], 1));
+    }
+
+    ParallelDescriptor::Gatherv(senddata.dataPtr(), nmtags[myProc],
+                                recvdata.dataPtr(), nmtags, offset, procToWrite);
+
+    if(myProc == procToWrite) {
+        hdr.m_chunk_size.resize(mf.size());
+        for(int j(0), N(mf.size()); j < N; ++j) {
+            const int i(pmap[j]);
+            hdr.m_chunk_size[j].assign(recvdata.begin() + offset[i],
+                                       recvdata.begin() + offset[i] + nChunks[j]);
+            offset[i] += nChunks[j];
+        }
+    }
+}
+
+
+void
+VisMF::readCompressedFAB (std::istream &is, Real *fabdata, Long npts,
+                          int scomp, int ncomp, int fabIndex, const Header &hdr)
+{
+    const Vector<Long> &chunkSize = hdr.m_chunk_size[fabIndex];
+    const Long nChunksPerComp((npts + hdr.m_chunk_points - 1) / hdr.m_chunk_points);
+    BL_ASSERT(chunkSize.size() == hdr.m_ncomp * nChunksPerComp);
+
+    // ---- skip the chunks of the components before scomp
+    auto firstChunk = chunkSize.begin() + scomp * nChunksPerComp;
+    Long skipBytes(std::accumulate(chunkSize.begin(), firstChunk, Long(0)));
+    if(skipBytes > 0) {
+        is.seekg(skipBytes, std::ios::cur);
+    }
+
+    Long readBytes(std::accumulate(firstChunk, firstChunk + ncomp * nChunksPerComp, Long(0)));
+    Vector<char> cdata(readBytes);
+    is.read(cdata.data(), readBytes);
+    if( ! is.good()) {
+        amrex::Error("VisMF::readCompressedFAB: read failed");
+    }
+
+    VisMF::uncompressFAB(cdata.data(), fabdata, npts, scomp, ncomp, fabIndex, hdr);
+}
+
+
+void
+VisMF::uncompressFAB (const char *cdata, Real *fabdata, Long npts,
+                      int scomp, int ncomp, int fabIndex, const Header &hdr)
+{
+    const Vector<Long> &chunkSize = hdr.m_chunk_size[fabIndex];
+    const Long chunkPoints(hdr.m_chunk_points);
+    const Long nChunksPerComp((npts + chunkPoints - 1) / chunkPoints);
+
+    const bool doConvert(hdr.m_writtenRD != FPC::NativeRealDescriptor());
+    const int wordSize(hdr.m_writtenRD.numBytes());
+    Vector<char> convertedData;
+
+    for(int n(0); n < ncomp; ++n) {
+        for(Long ichunk(0); ichunk < nChunksPerComp; ++ichunk) {
+            const Long ipt(ichunk * chunkPoints);
+            const Long nItems(std::min(chunkPoints, npts - ipt));
+            const Long csize(chunkSize[(scomp + n) * nChunksPerComp + ichunk]);
+            Real *chunkData = fabdata + n*npts + ipt;
+            if(doConvert) {
+                convertedData.resize(nItems * wordSize);
+                FabCompress::decompress(cdata, csize, convertedData.data(),
+                                        nItems * wordSize, wordSize);
+                RealDescriptor::convertToNativeFormat(chunkData, nItems,
+                                                      convertedData.data(), hdr.m_writtenRD);
+            } else {
+                FabCompress::decompress(cdata, csize, reinterpret_cast<char *>(chunkData),
+                                        nItems * wordSize, wordSize);
+            }
+            cdata += csize;
+        }
+    }
+}
+
+
+void
+VisMF::readFABsThreaded (FabArray<FArrayBox> &mf,
+                         const std::string   &mf_name,
+                         const VisMF::Header &hdr)
+{
+    BL_PROFILE("VisMF::readFABsThreaded()");
+
+    const bool compressed(hdr.m_vers == VisMF::Header::NoFabHeaderCompressed_v1);
+    const bool doConvert(hdr.m_writtenRD != FPC::NativeRealDescriptor());
+    const Long writtenRDBytes(hdr.m_writtenRD.numBytes());
+
+    // ---- the byte range of each local fab, sorted by file and offset
+    struct FabRange {
+        int  faIndex;
+        Long fileOffset;
+        Long nBytes;
+    };
+    Vector<FabRange> fabRanges;
+    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        const int idx(mfi.index());
+        Long nBytes;
+        if(compressed) {
+            nBytes = std::accumulate(hdr.m_chunk_size[idx].begin(),
+                                     hdr.m_chunk_size[idx].end(), Long(0));
+        } else {
+            nBytes = mf[mfi].box().numPts() * mf.nComp() * writtenRDBytes;
+        }
+        fabRanges.push_back(FabRange{idx, hdr.m_fod[idx].m_head, nBytes});
+    }
+    std::sort(fabRanges.begin(), fabRanges.end(),
+              [&hdr] (const FabRange &a, const FabRange &b)
+                  { return std::tie(hdr.m_fod[a.faIndex].m_name, a.fileOffset)
+                         < std::tie(hdr.m_fod[b.faIndex].m_name, b.fileOffset); });
+
+    // ---- merge fabs that are adjacent in a file into one read
+    struct ReadRange {
+        std::string fileName;
+        Long fileOffset;
+        Long nBytes;
+        Vector<FabRange> fabs;
+    };
+    Vector<ReadRange> readRanges;
+    for(const FabRange &fr : fabRanges) {
+        const std::string &fileName = hdr.m_fod[fr.faIndex].m_name;
+        if( ! readRanges.empty()) {
+            ReadRange &rr = readRanges.back();
+            if(rr.fileName == fileName && rr.fileOffset + rr.nBytes == fr.fileOffset &&
+               rr.nBytes + fr.nBytes <= coalescedReadSize)
+            {
+                rr.nBytes += fr.nBytes;
+                rr.fabs.push_back(fr);
+                continue;
+            }
+        }
+        readRanges.push_back(ReadRange{fileName, fr.fileOffset, fr.nBytes, {fr}});
+    }
+
+    const int nRanges(readRanges.size());
+    if(nRanges == 0) {
+        return;
+    }
+
+    // ---- the I/O threads read ahead at most maxInFlight ranges
+    const int nThreads(std::min(nReadThreads, nRanges));
+    const int maxInFlight(2 * nThreads);
+    std::mutex readMutex;
+    std::condition_variable readCV;
+    int nextRange(0), nInFlight(0);
+    bool stopReading(false);
+    std::map<int, Vector<char> > rangeData;     // ---- [range index, data]
+    std::map<int, std::string> failedFiles;     // ---- [range index, file name]
+
+    auto readRangesDoit = [&] ()
+    {
+        std::ifstream ifs;
+        std::string openFileName;
+        while(true) {
+            int ir;
+            {
+                std::unique_lock<std::mutex> lock(readMutex);
+                readCV.wait(lock, [&] { return stopReading || nInFlight < maxInFlight ||
+                                               nextRange >= nRanges; });
+                if(stopReading || nextRange >= nRanges) {
+                    return;
+                }
+                ir = nextRange++;
+                ++nInFlight;
+            }
+            const ReadRange &rr = readRanges[ir];
+            std::string fullFileName(VisMF::DirName(mf_name) + rr.fileName);
+            if(openFileName != fullFileName) {
+                ifs.close();
+                ifs.clear();
+                ifs.open(fullFileName.c_str(), std::ios::in | std::ios::binary);
+                openFileName = fullFileName;
+            }
+            Vector<char> data(rr.nBytes);
+            ifs.seekg(rr.fileOffset, std::ios::beg);
+            ifs.read(data.data(), rr.nBytes);
+            bool good(ifs.good());
+            if( ! good) {
+                openFileName.clear();
+            }
+            {
+                std::lock_guard<std::mutex> lock(readMutex);
+                if(good) {
+                    rangeData[ir] = std::move(data);
+                } else {
+                    failedFiles[ir] = fullFileName;
+                    rangeData[ir] = Vector<char>();
+                }
+            }
+            readCV.notify_all();
+        }
+    };
+
+    // ---- stop and join the I/O threads however this function is left,
+    // ---- so an error raised below does not unwind through joinable threads
+    Vector<std::thread> readThreads;
+    struct ReadThreadsJoiner {
+        Vector<std::thread> &threads;
+        std::mutex &mtx;
+        std::condition_variable &cv;
+        bool &stop;
+        ~ReadThreadsJoiner () {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                stop = true;
+            }
+            cv.notify_all();
+            for(auto &t : threads) {
+                t.join();
+            }
+        }
+    } readThreadsJoiner{readThreads, readMutex, readCV, stopReading};
+
+    for(int i(0); i < nThreads; ++i) {
+        readThreads.emplace_back(readRangesDoit);
+    }
+
+    // ---- convert the data in file order while the next ranges are read
+    for(int ir(0); ir < nRanges; ++ir) {
+        Vector<char> data;
+        {
+            std::unique_lock<std::mutex> lock(readMutex);
+            readCV.wait(lock, [&] { return rangeData.count(ir) > 0; });
+            auto ffIter = failedFiles.find(ir);
+            if(ffIter != failedFiles.end()) {
+                amrex::FileOpenFailed(ffIter->second);
+            }
+            data = std::move(rangeData[ir]);
+            rangeData.erase(ir);
+            --nInFlight;
+        }
+        readCV.notify_all();
+
+        const char *rangePtr = data.data();
+        for(const FabRange &fr : readRanges[ir].fabs) {
+            FArrayBox &fab = mf[fr.faIndex];
+            Real* fabdata = fab.dataPtr();
+#ifdef AMREX_USE_GPU
+            std::unique_ptr<FArrayBox> hostfab;
+            if (fab.arena()->isManaged() || fab.arena()->isDevice()) {
+                hostfab = std::make_unique<FArrayBox>(fab.box(), fab.nComp(), The_Pinned_Arena());
+                fabdata = hostfab->dataPtr();
+            }
+#endif
+            const Long npts(fab.box().numPts());
+            if(compressed) {
+                VisMF::uncompressFAB(rangePtr, fabdata, npts, 0, fab.nComp(), fr.faIndex, hdr);
+            } else if(doConvert) {
+                RealDescriptor::convertToNativeFormat(fabdata, npts * fab.nComp(),
+                                                      const_cast<char *>(rangePtr), hdr.m_writtenRD);
+            } else {
+                std::memcpy(fabdata, rangePtr, fab.nBytes());
+            }
+#ifdef AMREX_USE_GPU
+            if (hostfab) {
+                Gpu::htod_memcpy_async(fab.dataPtr(), hostfab->dataPtr(), fab.size()*sizeof(Real));
+                Gpu::streamSynchronize();
+            }
+#endif
+            rangePtr += fr.nBytes;
+        }
+    }
+}
+
+
 void
 VisMF::RemoveFiles(const std::string &mf_name, bool a_verbose)
 {
@@ -1401,7 +2176,13 @@ VisMF::readFAB (int                  idx,
           fabdata = hostfab->dataPtr();
       }
 #endif
-      if(whichComp == -1) {    // ---- read all components
+      if(hdr.m_vers == Header::NoFabHeaderCompressed_v1) {
+        if(whichComp == -1) {    // ---- read all components
+          VisMF::readCompressedFAB(*infs, fabdata, fab->box().numPts(), 0, fab->nComp(), idx, hdr);
+        } else {
+          VisMF::readCompressedFAB(*infs, fabdata, fab->box().numPts(), whichComp, 1, idx, hdr);
+        }
+      } else if(whichComp == -1) {    // ---- read all components
         if(hdr.m_writtenRD == FPC::NativeRealDescriptor()) {
           infs->read((char *) fabdata, fab->nBytes());
         } else {
@@ -1459,7 +2240,9 @@ VisMF::readFAB (FabArray<FArrayBox> &mf,
           fabdata = hostfab->dataPtr();
       }
 #endif
-      if(hdr.m_writtenRD == FPC::NativeRealDescriptor()) {
+      if(hdr.m_vers == Header::NoFabHeaderCompressed_v1) {
+        VisMF::readCompressedFAB(*infs, fabdata, fab.box().numPts(), 0, fab.nComp(), idx, hdr);
+      } else if(hdr.m_writtenRD == FPC::NativeRealDescriptor()) {
         infs->read((char *) fabdata, fab.nBytes());
       } else {
         Long readDataItems(fab.box().numPts() * fab.nComp());
@@ -1544,8 +2327,14 @@ VisMF::Read (FabArray<FArrayBox> &mf,
   int nOpensPerFile(nMFFileInStreams);
   int nProcs(ParallelDescriptor::NProcs());
   bool noFabHeader(NoFabHeader(hdr));
+  bool compressed(hdr.m_vers == VisMF::Header::NoFabHeaderCompressed_v1);
+
+  if(noFabHeader && useThreadedReads) {
+
+    VisMF::readFABsThreaded(mf, mf_name, hdr);
 
-  if(noFabHeader && useSynchronousReads) {
+  // ---- the synchronous reads need uncompressed fab sizes
+  } else if(noFabHeader && useSynchronousReads && ! compressed) {
 
     // ---- This code is only for reading in file order
     bool doConvert(hdr.m_writtenRD != FPC::NativeRealDescriptor());
@@ -1781,7 +2570,7 @@ VisMF::Read (FabArray<FArrayBox> &mf,
       faCopyTime = amrex::second() - faCopyTime;
     }
 
-  } else {    // ---- (noFabHeader && useSynchronousReads) == false
+  } else {    // ---- neither threaded nor synchronous reads
 
     int nReqs(0), ioProcNum(coordinatorProc);
     int nBoxes(hdr.m_ba.size());
@@ -1942,8 +2731,12 @@ VisMF::Read (FabArray<FArrayBox> &mf,
   }
 
 #else
-    for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
-      VisMF::readFAB(mf,mfi.index(), mf_name, hdr);
+    if(NoFabHeader(hdr) && useThreadedReads) {
+      VisMF::readFABsThreaded(mf, mf_name, hdr);
+    } else {
+      for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        VisMF::readFAB(mf,mfi.index(), mf_name, hdr);
+      }
     }
 #endif
 
@@ -2122,7 +2915,8 @@ VisMF::clear ()
 bool VisMF::NoFabHeader(const VisMF::Header &hdr) {
   if(hdr.m_vers == VisMF::Header::NoFabHeader_v1       ||
     hdr.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
-    hdr.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1)
+    hdr.m_vers == VisMF::Header::NoFabHeaderFAMinMax_v1 ||
+    hdr.m_vers == VisMF::Header::NoFabHeaderCompressed_v1)
   {
     return true;
   }
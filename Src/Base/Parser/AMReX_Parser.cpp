@@ -113,6 +113,26 @@ Parser::expr () const
     }
 }
 
+void
+Parser::eliminateCommonSubexpressions () const
+{
+    int max_stack_size, stack_size;
+    parser_exe_size(m_data->m_parser, max_stack_size, stack_size);
+
+    // Each temporary takes a slot on the stack.
+    struct amrex_parser* p = parser_cse(m_data->m_parser,
+                                        AMREX_PARSER_STACK_SIZE - max_stack_size);
+    if (p) {
+        parser_exe_size(p, max_stack_size, stack_size);
+        if (max_stack_size <= AMREX_PARSER_STACK_SIZE && stack_size == 0) {
+            amrex_parser_delete(m_data->m_parser);
+            m_data->m_parser = p;
+        } else {
+            amrex_parser_delete(p);
+        }
+    }
+}
+
 std::set<std::string>
 Parser::symbols () const
 {
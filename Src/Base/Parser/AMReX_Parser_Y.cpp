@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cstdarg>
 #include <string>
+#include <vector>
 
 void
 amrex_parsererror (char const *s, ...)
@@ -1605,6 +1606,264 @@ void parser_ast_get_symbols (struct parser_node* node, std::set<std::string>& sy
     }
 }
 
+namespace {
+
+// Number of operations in an expression, or -1 if it contains assignments.
+int
+parser_ast_cost (struct parser_node* node)
+{
+    switch (node->type)
+    {
+    case PARSER_NUMBER:
+    case PARSER_SYMBOL:
+        return 0;
+    case PARSER_ADD:
+    case PARSER_SUB:
+    case PARSER_MUL:
+    case PARSER_DIV:
+    {
+        int cl = parser_ast_cost(node->l);
+        int cr = parser_ast_cost(node->r);
+        return (cl < 0 || cr < 0) ? -1 : 1+cl+cr;
+    }
+    case PARSER_NEG:
+    {
+        int c = parser_ast_cost(node->l);
+        return (c < 0) ? -1 : 1+c;
+    }
+    case PARSER_F1:
+    {
+        int c = parser_ast_cost(((struct parser_f1*)node)->l);
+        return (c < 0) ? -1 : 1+c;
+    }
+    case PARSER_F2:
+    {
+        int cl = parser_ast_cost(((struct parser_f2*)node)->l);
+        int cr = parser_ast_cost(((struct parser_f2*)node)->r);
+        return (cl < 0 || cr < 0) ? -1 : 1+cl+cr;
+    }
+    case PARSER_F3:
+    {
+        int c1 = parser_ast_cost(((struct parser_f3*)node)->n1);
+        int c2 = parser_ast_cost(((struct parser_f3*)node)->n2);
+        int c3 = parser_ast_cost(((struct parser_f3*)node)->n3);
+        return (c1 < 0 || c2 < 0 || c3 < 0) ? -1 : 1+c1+c2+c3;
+    }
+    case PARSER_ADD_VP:
+    case PARSER_SUB_VP:
+    case PARSER_MUL_VP:
+    case PARSER_DIV_VP:
+    case PARSER_ADD_PP:
+    case PARSER_SUB_PP:
+    case PARSER_MUL_PP:
+    case PARSER_DIV_PP:
+    case PARSER_NEG_P:
+        return 1;
+    default:
+        return -1;
+    }
+}
+
+// Are the two expressions the same up to the order of the operands of + and *?
+bool
+parser_ast_equal (struct parser_node* a, struct parser_node* b)
+{
+    if (a->type != b->type) { return false; }
+
+    switch (a->type)
+    {
+    case PARSER_NUMBER:
+        return ((struct parser_number*)a)->value == ((struct parser_number*)b)->value;
+    case PARSER_SYMBOL:
+        return std::strcmp(((struct parser_symbol*)a)->name,
+                           ((struct parser_symbol*)b)->name) == 0;
+    case PARSER_ADD:
+    case PARSER_MUL:
+    case PARSER_ADD_PP:
+    case PARSER_MUL_PP:
+        return (parser_ast_equal(a->l, b->l) && parser_ast_equal(a->r, b->r))
+            || (parser_ast_equal(a->l, b->r) && parser_ast_equal(a->r, b->l));
+    case PARSER_SUB:
+    case PARSER_DIV:
+    case PARSER_SUB_PP:
+    case PARSER_DIV_PP:
+        return parser_ast_equal(a->l, b->l) && parser_ast_equal(a->r, b->r);
+    case PARSER_NEG:
+    case PARSER_NEG_P:
+        return parser_ast_equal(a->l, b->l);
+    case PARSER_F1:
+        return ((struct parser_f1*)a)->ftype == ((struct parser_f1*)b)->ftype
+            && parser_ast_equal(((struct parser_f1*)a)->l, ((struct parser_f1*)b)->l);
+    case PARSER_F2:
+        return ((struct parser_f2*)a)->ftype == ((struct parser_f2*)b)->ftype
+            && parser_ast_equal(((struct parser_f2*)a)->l, ((struct parser_f2*)b)->l)
+            && parser_ast_equal(((struct parser_f2*)a)->r, ((struct parser_f2*)b)->r);
+    case PARSER_F3:
+        return ((struct parser_f3*)a)->ftype == ((struct parser_f3*)b)->ftype
+            && parser_ast_equal(((struct parser_f3*)a)->n1, ((struct parser_f3*)b)->n1)
+            && parser_ast_equal(((struct parser_f3*)a)->n2, ((struct parser_f3*)b)->n2)
+            && parser_ast_equal(((struct parser_f3*)a)->n3, ((struct parser_f3*)b)->n3);
+    case PARSER_ADD_VP:
+    case PARSER_SUB_VP:
+    case PARSER_MUL_VP:
+    case PARSER_DIV_VP:
+        return a->lvp.v == b->lvp.v && parser_ast_equal(a->r, b->r);
+    default:
+        return false;
+    }
+}
+
+struct parser_cse_ref {
+    struct parser_node** slot; // where the subexpression is referenced
+    int cost;
+    bool conditional;          // Is it inside a branch of if?
+};
+
+void
+parser_cse_collect (struct parser_node** slot, bool conditional,
+                    std::vector<parser_cse_ref>& refs)
+{
+    struct parser_node* node = *slot;
+    int cost = parser_ast_cost(node);
+    if (cost >= 2) {
+        refs.push_back(parser_cse_ref{slot, cost, conditional});
+    }
+
+    switch (node->type)
+    {
+    case PARSER_ADD:
+    case PARSER_SUB:
+    case PARSER_MUL:
+    case PARSER_DIV:
+        parser_cse_collect(&(node->l), conditional, refs);
+        parser_cse_collect(&(node->r), conditional, refs);
+        break;
+    case PARSER_NEG:
+        parser_cse_collect(&(node->l), conditional, refs);
+        break;
+    case PARSER_F1:
+        parser_cse_collect(&(((struct parser_f1*)node)->l), conditional, refs);
+        break;
+    case PARSER_F2:
+        parser_cse_collect(&(((struct parser_f2*)node)->l), conditional, refs);
+        parser_cse_collect(&(((struct parser_f2*)node)->r), conditional, refs);
+        break;
+    case PARSER_F3:
+        parser_cse_collect(&(((struct parser_f3*)node)->n1), conditional, refs);
+        parser_cse_collect(&(((struct parser_f3*)node)->n2), true, refs);
+        parser_cse_collect(&(((struct parser_f3*)node)->n3), true, refs);
+        break;
+    default:
+        break;
+    }
+}
+
+void
+parser_cse_statements (struct parser_node* node, std::vector<struct parser_node*>& stmts)
+{
+    if (node->type == PARSER_LIST) {
+        parser_cse_statements(node->l, stmts);
+        parser_cse_statements(node->r, stmts);
+    } else {
+        stmts.push_back(node);
+    }
+}
+
+}
+
+/* Common subexpression elimination.  Subexpressions that appear more than
+ * once in a statement are computed once and stored in local variables named
+ * cse.0, cse.1, ..., which cannot clash with user symbols.  At most
+ * max_temps local variables are added.  Returns a new parser, or nullptr if
+ * there is nothing to eliminate.
+ */
+struct amrex_parser*
+parser_cse (struct amrex_parser* parser, int max_temps)
+{
+    if (max_temps <= 0) { return nullptr; }
+
+    // We modify a copy, and new nodes are allocated with malloc.
+    struct amrex_parser* work = parser_dup(parser);
+    std::vector<void*> allocated;
+
+    std::vector<struct parser_node*> stmts;
+    parser_cse_statements(work->ast, stmts);
+
+    std::vector<struct parser_node*> new_stmts;
+    int ntemps = 0;
+    for (auto stmt : stmts) {
+        struct parser_node** root = (stmt->type == PARSER_ASSIGN)
+            ? &(((struct parser_assign*)stmt)->v) : &stmt;
+        // Assignments to the temporaries, in the order of evaluation
+        std::vector<struct parser_node*> temps;
+        while (ntemps < max_temps && parser_ast_cost(*root) > 0) {
+            std::vector<parser_cse_ref> refs;
+            parser_cse_collect(root, false, refs);
+            for (auto t : temps) {
+                parser_cse_collect(&(((struct parser_assign*)t)->v), false, refs);
+            }
+            std::stable_sort(refs.begin(), refs.end(),
+                             [] (parser_cse_ref const& a, parser_cse_ref const& b)
+                             { return a.cost > b.cost; });
+
+            // The most expensive subexpression that appears more than once
+            // and is evaluated unconditionally at least once.
+            std::vector<struct parser_node**> slots;
+            for (std::size_t i = 0; i < refs.size() && slots.empty(); ++i) {
+                if (refs[i].conditional) { continue; }
+                for (std::size_t j = 0; j < refs.size() && refs[j].cost >= refs[i].cost; ++j) {
+                    if (j == i || (refs[j].cost == refs[i].cost &&
+                                   parser_ast_equal(*refs[i].slot, *refs[j].slot))) {
+                        slots.push_back(refs[j].slot);
+                    }
+                }
+                if (slots.size() < 2) { slots.clear(); }
+            }
+            if (slots.empty()) { break; }
+
+            std::string name = "cse." + std::to_string(ntemps++);
+            // A subexpression that contains another one has a higher cost,
+            // so it has been extracted already and the new temporary must
+            // be evaluated first.
+            struct parser_symbol* s = parser_makesymbol(&name[0]);
+            allocated.push_back(s->name);
+            allocated.push_back(s);
+            struct parser_node* asgn = parser_newassign(s, *slots[0]);
+            allocated.push_back(asgn);
+            temps.insert(temps.begin(), asgn);
+            for (auto slot : slots) {
+                s = parser_makesymbol(&name[0]);
+                allocated.push_back(s->name);
+                allocated.push_back(s);
+                *slot = (struct parser_node*)s;
+            }
+        }
+        new_stmts.insert(new_stmts.end(), temps.begin(), temps.end());
+        new_stmts.push_back(stmt);
+    }
+
+    struct amrex_parser* result = nullptr;
+    if (ntemps > 0) {
+        struct parser_node* ast = new_stmts[0];
+        for (std::size_t i = 1; i < new_stmts.size(); ++i) {
+            ast = parser_newlist(ast, new_stmts[i]);
+            allocated.push_back(ast);
+        }
+
+        result = (struct amrex_parser*) std::malloc(sizeof(struct amrex_parser));
+        result->sz_mempool = parser_ast_size(ast);
+        result->p_root = std::malloc(result->sz_mempool);
+        result->p_free = result->p_root;
+        result->ast = parser_ast_dup(result, ast, 0); /* 0: don't free the source */
+        parser_ast_optimize(result->ast);
+    }
+
+    for (auto p : allocated) { std::free(p); }
+    amrex_parser_delete(work);
+
+    return result;
+}
+
 void
 parser_regvar (struct amrex_parser* parser, char const* name, int i)
 {
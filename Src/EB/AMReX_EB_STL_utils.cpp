@@ -1,7 +1,10 @@
 #include <AMReX_EB_STL_utils.H>
 #include <AMReX_EB_triGeomOps_K.H>
 #include <AMReX_IntConv.H>
+#include <algorithm>
+#include <array>
 #include <cstring>
+#include <numeric>
 
 namespace amrex
 {
@@ -89,6 +92,150 @@ namespace {
             return std::make_pair(false,0.0_rt);
         }
     }
+
+    // Do boxes [alo,ahi] and [blo,bhi] overlap?
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    bool box_box_overlaps (XDim3 const& alo, XDim3 const& ahi,
+                           XDim3 const& blo, XDim3 const& bhi)
+    {
+        return !(alo.x > bhi.x || ahi.x < blo.x ||
+                 alo.y > bhi.y || ahi.y < blo.y ||
+                 alo.z > bhi.z || ahi.z < blo.z);
+    }
+
+    // Does line ab intersect with box [lo-pad,hi+pad]?  The padding makes
+    // the test conservative with respect to roundoff errors.
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    bool line_box_intersects (Real const a[3], Real const b[3],
+                              XDim3 const& lo, XDim3 const& hi, Real pad)
+    {
+        Real const blo[] = {lo.x-pad, lo.y-pad, lo.z-pad};
+        Real const bhi[] = {hi.x+pad, hi.y+pad, hi.z+pad};
+        Real tmin = 0._rt;
+        Real tmax = 1._rt;
+        for (int d = 0; d < 3; ++d) {
+            Real dir = b[d] - a[d];
+            if (dir == 0._rt) {
+                if (a[d] < blo[d] || a[d] > bhi[d]) { return false; }
+            } else {
+                Real t1 = (blo[d]-a[d]) / dir;
+                Real t2 = (bhi[d]-a[d]) / dir;
+                tmin = amrex::max(tmin, amrex::min(t1,t2));
+                tmax = amrex::min(tmax, amrex::max(t1,t2));
+                if (tmin > tmax) { return false; }
+            }
+        }
+        return true;
+    }
+
+    // Call f on the triangles in the BVH leaves reachable through nodes
+    // accepted by visit_node.  The traversal stops if f returns true.
+    template <typename P, typename F>
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void bvh_traverse (STLtools::BVHNode const* nodes, int const* tri_ids,
+                       P const& visit_node, F const& f)
+    {
+        int stack[STLtools::bvh_max_depth+1];
+        int nstack = 0;
+        stack[nstack++] = 0;
+        while (nstack > 0) {
+            STLtools::BVHNode const& node = nodes[stack[--nstack]];
+            if (visit_node(node)) {
+                if (node.count > 0) {
+                    for (int n = node.first; n < node.first+node.count; ++n) {
+                        if (f(tri_ids[n])) { return; }
+                    }
+                } else {
+                    stack[nstack++] = node.first+1;
+                    stack[nstack++] = node.first;
+                }
+            }
+        }
+    }
+
+    // Number of triangles, other than skip, intersected by line ab
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    int bvh_num_intersects (Real a[3], Real b[3], STLtools::BVHNode const* nodes,
+                            int const* tri_ids, STLtools::Triangle const* tri_pts,
+                            Real pad, int skip = -1)
+    {
+        int num_intersects = 0;
+        bvh_traverse(nodes, tri_ids,
+                     [&] (STLtools::BVHNode const& node) -> bool
+                     {
+                         return line_box_intersects(a, b, node.lo, node.hi, pad);
+                     },
+                     [&] (int it) -> bool
+                     {
+                         if (it != skip && line_tri_intersects(a, b, tri_pts[it])) {
+                             ++num_intersects;
+                         }
+                         return false;
+                     });
+        return num_intersects;
+    }
+
+    // Intersection of the edge p1->p1+(x2-p1[idim])e_idim with the
+    // triangles.  If there are multiple intersections, the one with the
+    // lowest triangle index is returned so that the result does not
+    // depend on the tree layout.
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    std::pair<bool,Real> bvh_edge_intersects (int idim, XDim3 const& p1, Real x2,
+                                              Real dlevset,
+                                              STLtools::BVHNode const* nodes,
+                                              int const* tri_ids,
+                                              STLtools::Triangle const* tri_pts,
+                                              XDim3 const* tri_norm)
+    {
+        XDim3 p2 = p1;
+        if (idim == 0) {
+            p2.x = x2;
+        } else if (idim == 1) {
+            p2.y = x2;
+        } else {
+            p2.z = x2;
+        }
+        int itmin = std::numeric_limits<int>::max();
+        Real r = 0.0_rt;
+        bvh_traverse(nodes, tri_ids,
+                     [&] (STLtools::BVHNode const& node) -> bool
+                     {
+                         return box_box_overlaps(p1, p2, node.lo, node.hi);
+                     },
+                     [&] (int it) -> bool
+                     {
+                         if (it < itmin) {
+                             auto const& tri = tri_pts[it];
+                             auto const& norm = tri_norm[it];
+                             std::pair<bool,Real> tmp;
+                             if (idim == 0) {
+                                 tmp = edge_tri_intersects(p1.x, x2, p1.y, p1.z,
+                                                           tri.v1, tri.v2, tri.v3,
+                                                           norm, dlevset);
+                             } else if (idim == 1) {
+                                 tmp = edge_tri_intersects(p1.y, x2, p1.z, p1.x,
+                                                           {tri.v1.y, tri.v1.z, tri.v1.x},
+                                                           {tri.v2.y, tri.v2.z, tri.v2.x},
+                                                           {tri.v3.y, tri.v3.z, tri.v3.x},
+                                                           {  norm.y,   norm.z,   norm.x},
+                                                           dlevset);
+                             } else {
+                                 tmp = edge_tri_intersects(p1.z, x2, p1.x, p1.y,
+                                                           {tri.v1.z, tri.v1.x, tri.v1.y},
+                                                           {tri.v2.z, tri.v2.x, tri.v2.y},
+                                                           {tri.v3.z, tri.v3.x, tri.v3.y},
+                                                           {  norm.z,   norm.x,   norm.y},
+                                                           dlevset);
+                             }
+                             if (tmp.first) {
+                                 itmin = it;
+                                 r = tmp.second;
+                             }
+                         }
+                         return false;
+                     });
+        return std::make_pair(itmin != std::numeric_limits<int>::max(), r);
+    }
 }
 
 void
@@ -242,6 +389,9 @@ STLtools::prepare ()
     if (!ParallelDescriptor::IOProcessor()) {
         m_tri_pts_h.resize(m_num_tri);
     }
+    ParallelDescriptor::Bcast((char*)(m_tri_pts_h.dataPtr()), m_num_tri*sizeof(Triangle));
+
+    build_bvh();
 
     //device vectors
     m_tri_pts_d.resize(m_num_tri);
@@ -398,31 +548,132 @@ STLtools::prepare ()
 
     // We now need to figure out if the boundary and the reference is
     // outside or inside the object.
-    XDim3 ptref = m_ptref;
-    int num_isects = Reduce::Sum<int>(m_num_tri, [=] AMREX_GPU_DEVICE (int i) -> int
-        {
-            if (i == 0) {
-                return 1-is_ref_positive;
-            } else {
-                Real p1[] = {ptref.x, ptref.y, ptref.z};
-                Real p2[] = {cent0.x, cent0.y, cent0.z};
-                return static_cast<int>(line_tri_intersects(p1, p2, tri_pts[i]));
-            }
-        });
+    int num_isects;
+    {
+        Real p1[] = {m_ptref.x, m_ptref.y, m_ptref.z};
+        Real p2[] = {cent0.x, cent0.y, cent0.z};
+        num_isects = 1-is_ref_positive
+            + bvh_num_intersects(p1, p2, m_bvh_nodes_h.data(), m_bvh_tri_ids_h.data(),
+                                 m_tri_pts_h.data(), m_bvh_pad, 0);
+    }
 
     m_boundry_is_outside = num_isects % 2 == 0;
 }
 
+void
+STLtools::build_bvh ()
+{
+    // Bounding boxes and centroids of the triangles
+    Vector<XDim3> tlo(m_num_tri), thi(m_num_tri);
+    Vector<std::array<Real,3> > cent(m_num_tri);
+    for (int i = 0; i < m_num_tri; ++i) {
+        Triangle const& tri = m_tri_pts_h[i];
+        tlo[i] = XDim3{amrex::min(tri.v1.x,tri.v2.x,tri.v3.x),
+                       amrex::min(tri.v1.y,tri.v2.y,tri.v3.y),
+                       amrex::min(tri.v1.z,tri.v2.z,tri.v3.z)};
+        thi[i] = XDim3{amrex::max(tri.v1.x,tri.v2.x,tri.v3.x),
+                       amrex::max(tri.v1.y,tri.v2.y,tri.v3.y),
+                       amrex::max(tri.v1.z,tri.v2.z,tri.v3.z)};
+        cent[i] = {(tri.v1.x + tri.v2.x + tri.v3.x) / 3._rt,
+                   (tri.v1.y + tri.v2.y + tri.v3.y) / 3._rt,
+                   (tri.v1.z + tri.v2.z + tri.v3.z) / 3._rt};
+    }
+
+    m_bvh_tri_ids_h.resize(m_num_tri);
+    int* ids = m_bvh_tri_ids_h.data();
+    std::iota(ids, ids+m_num_tri, 0);
+
+    m_bvh_nodes_h.clear();
+    m_bvh_nodes_h.reserve(2*(m_num_tri/bvh_leaf_size)+1);
+    m_bvh_nodes_h.push_back(BVHNode{});
+
+    // The tree is built top down by splitting the triangles at the median
+    // centroid along the longest axis of the centroids' bounding box.  The
+    // result is the same on all processes.
+    struct Range {
+        int node, begin, end, depth;
+    };
+    Vector<Range> todo{{0, 0, m_num_tri, 0}};
+    while (!todo.empty()) {
+        const Range r = todo.back();
+        todo.pop_back();
+
+        constexpr Real big = std::numeric_limits<Real>::max();
+        XDim3 lo{big,big,big}, hi{-big,-big,-big};
+        std::array<Real,3> clo{big,big,big}, chi{-big,-big,-big};
+        for (int n = r.begin; n < r.end; ++n) {
+            int it = ids[n];
+            lo.x = amrex::min(lo.x, tlo[it].x);
+            lo.y = amrex::min(lo.y, tlo[it].y);
+            lo.z = amrex::min(lo.z, tlo[it].z);
+            hi.x = amrex::max(hi.x, thi[it].x);
+            hi.y = amrex::max(hi.y, thi[it].y);
+            hi.z = amrex::max(hi.z, thi[it].z);
+            for (int d = 0; d < 3; ++d) {
+                clo[d] = amrex::min(clo[d], cent[it][d]);
+                chi[d] = amrex::max(chi[d], cent[it][d]);
+            }
+        }
+        m_bvh_nodes_h[r.node].lo = lo;
+        m_bvh_nodes_h[r.node].hi = hi;
+
+        if (r.end - r.begin <= bvh_leaf_size) {
+            m_bvh_nodes_h[r.node].first = r.begin;
+            m_bvh_nodes_h[r.node].count = r.end - r.begin;
+        } else {
+            int axis = 0;
+            for (int d = 1; d < 3; ++d) {
+                if (chi[d]-clo[d] > chi[axis]-clo[axis]) { axis = d; }
+            }
+            int mid = (r.begin + r.end) / 2;
+            std::nth_element(ids+r.begin, ids+mid, ids+r.end,
+                             [&] (int a, int b) {
+                                 return (cent[a][axis] < cent[b][axis]) ||
+                                     (cent[a][axis] == cent[b][axis] && a < b);
+                             });
+            int left = static_cast<int>(m_bvh_nodes_h.size());
+            m_bvh_nodes_h[r.node].first = left;
+            m_bvh_nodes_h[r.node].count = 0;
+            m_bvh_nodes_h.push_back(BVHNode{});
+            m_bvh_nodes_h.push_back(BVHNode{});
+            AMREX_ALWAYS_ASSERT(r.depth+1 < bvh_max_depth);
+            todo.push_back({left+1, mid, r.end, r.depth+1});
+            todo.push_back({left, r.begin, mid, r.depth+1});
+        }
+    }
+
+    {
+        BVHNode const& root = m_bvh_nodes_h[0];
+        Real L = amrex::max(amrex::max(std::abs(root.lo.x), std::abs(root.lo.y),
+                                       std::abs(root.lo.z)),
+                            amrex::max(std::abs(root.hi.x), std::abs(root.hi.y),
+                                       std::abs(root.hi.z)));
+        m_bvh_pad = 1.e3_rt * std::numeric_limits<Real>::epsilon() * L;
+    }
+
+    if (amrex::Verbose() > 0) {
+        amrex::Print() << "    Number of BVH nodes: " << m_bvh_nodes_h.size() << std::endl;
+    }
+
+    m_bvh_nodes_d.resize(m_bvh_nodes_h.size());
+    m_bvh_tri_ids_d.resize(m_num_tri);
+    Gpu::copyAsync(Gpu::hostToDevice, m_bvh_nodes_h.begin(), m_bvh_nodes_h.end(),
+                   m_bvh_nodes_d.begin());
+    Gpu::copyAsync(Gpu::hostToDevice, m_bvh_tri_ids_h.begin(), m_bvh_tri_ids_h.end(),
+                   m_bvh_tri_ids_d.begin());
+}
+
 void
 STLtools::fill (MultiFab& mf, IntVect const& nghost, Geometry const& geom,
                 Real outside_value, Real inside_value) const
 {
-    int num_triangles = m_num_tri;
-
     const auto plo = geom.ProbLoArray();
     const auto dx  = geom.CellSizeArray();
 
     const Triangle* tri_pts = m_tri_pts_d.data();
+    const BVHNode* bvh_nodes = m_bvh_nodes_d.data();
+    const int* bvh_tri_ids = m_bvh_tri_ids_d.data();
+    Real bvh_pad = m_bvh_pad;
     XDim3 ptmin = m_ptmin;
     XDim3 ptmax = m_ptmax;
     XDim3 ptref = m_ptref;
@@ -447,11 +698,8 @@ STLtools::fill (MultiFab& mf, IntVect const& nghost, Geometry const& geom,
             coords[2] >= ptmin.z && coords[2] <= ptmax.z)
         {
             Real pr[]={ptref.x, ptref.y, ptref.z};
-            for (int tr=0; tr < num_triangles; ++tr) {
-                if (line_tri_intersects(pr, coords, tri_pts[tr])) {
-                    ++num_intersects;
-                }
-            }
+            num_intersects = bvh_num_intersects(pr, coords, bvh_nodes, bvh_tri_ids,
+                                                tri_pts, bvh_pad);
         }
         ma[box_no](i,j,k) = (num_intersects % 2 == 0) ? reference_value : other_value;
     });
@@ -489,8 +737,38 @@ STLtools::getBoxType (Box const& box, Geometry const& geom, RunOn) const
     }
     else
     {
-        int num_triangles = m_num_tri;
+        // If the box is inside the bounding box and no triangle comes near
+        // it, all its points are on the same side of the surface and we
+        // only need to check one of them.
+        bool has_triangles = true;
+        if (blo.x >= m_ptmin.x && blo.y >= m_ptmin.y && blo.z >= m_ptmin.z &&
+            bhi.x <= m_ptmax.x && bhi.y <= m_ptmax.y && bhi.z <= m_ptmax.z)
+        {
+            has_triangles = false;
+            bvh_traverse(m_bvh_nodes_h.data(), m_bvh_tri_ids_h.data(),
+                         [&] (BVHNode const& node) -> bool
+                         {
+                             return box_box_overlaps(blo, bhi, node.lo, node.hi);
+                         },
+                         [&] (int it) -> bool
+                         {
+                             Triangle const& tri = m_tri_pts_h[it];
+                             XDim3 tlo{amrex::min(tri.v1.x,tri.v2.x,tri.v3.x),
+                                       amrex::min(tri.v1.y,tri.v2.y,tri.v3.y),
+                                       amrex::min(tri.v1.z,tri.v2.z,tri.v3.z)};
+                             XDim3 thi{amrex::max(tri.v1.x,tri.v2.x,tri.v3.x),
+                                       amrex::max(tri.v1.y,tri.v2.y,tri.v3.y),
+                                       amrex::max(tri.v1.z,tri.v2.z,tri.v3.z)};
+                             has_triangles = box_box_overlaps(blo, bhi, tlo, thi);
+                             return has_triangles;
+                         });
+        }
+        const Box& eval_box = has_triangles ? box : Box(box.smallEnd(), box.smallEnd());
+
         const Triangle* tri_pts = m_tri_pts_d.data();
+        const BVHNode* bvh_nodes = m_bvh_nodes_d.data();
+        const int* bvh_tri_ids = m_bvh_tri_ids_d.data();
+        Real bvh_pad = m_bvh_pad;
         XDim3 ptmin = m_ptmin;
         XDim3 ptmax = m_ptmax;
         XDim3 ptref = m_ptref;
@@ -499,7 +777,7 @@ STLtools::getBoxType (Box const& box, Geometry const& geom, RunOn) const
         ReduceOps<ReduceOpSum> reduce_op;
         ReduceData<int> reduce_data(reduce_op);
         using ReduceTuple = typename decltype(reduce_data)::Type;
-        reduce_op.eval(box, reduce_data,
+        reduce_op.eval(eval_box, reduce_data,
         [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
         {
             Real coords[3];
@@ -517,18 +795,15 @@ STLtools::getBoxType (Box const& box, Geometry const& geom, RunOn) const
                 coords[2] >= ptmin.z && coords[2] <= ptmax.z)
             {
                 Real pr[]={ptref.x, ptref.y, ptref.z};
-                for (int tr=0; tr < num_triangles; ++tr) {
-                    if (line_tri_intersects(pr, coords, tri_pts[tr])) {
-                        ++num_intersects;
-                    }
-                }
+                num_intersects = bvh_num_intersects(pr, coords, bvh_nodes, bvh_tri_ids,
+                                                    tri_pts, bvh_pad);
             }
 
             return (num_intersects % 2 == 0) ? ref_value : 1-ref_value;
         });
         ReduceTuple hv = reduce_data.value(reduce_op);
         Long nfluid = static_cast<Long>(amrex::get<0>(hv));
-        Long npts = box.numPts();
+        Long npts = eval_box.numPts();
         if (nfluid == 0) {
             return allcovered;
         } else if (nfluid == npts) {
@@ -542,12 +817,13 @@ STLtools::getBoxType (Box const& box, Geometry const& geom, RunOn) const
 void
 STLtools::fillFab (BaseFab<Real>& levelset, const Geometry& geom, RunOn, Box const&) const
 {
-    int num_triangles = m_num_tri;
-
     const auto plo = geom.ProbLoArray();
     const auto dx  = geom.CellSizeArray();
 
     const Triangle* tri_pts = m_tri_pts_d.data();
+    const BVHNode* bvh_nodes = m_bvh_nodes_d.data();
+    const int* bvh_tri_ids = m_bvh_tri_ids_d.data();
+    Real bvh_pad = m_bvh_pad;
     XDim3 ptmin = m_ptmin;
     XDim3 ptmax = m_ptmax;
     XDim3 ptref = m_ptref;
@@ -572,11 +848,8 @@ STLtools::fillFab (BaseFab<Real>& levelset, const Geometry& geom, RunOn, Box con
             coords[2] >= ptmin.z && coords[2] <= ptmax.z)
         {
             Real pr[]={ptref.x, ptref.y, ptref.z};
-            for (int tr=0; tr < num_triangles; ++tr) {
-                if (line_tri_intersects(pr, coords, tri_pts[tr])) {
-                    ++num_intersects;
-                }
-            }
+            num_intersects = bvh_num_intersects(pr, coords, bvh_nodes, bvh_tri_ids,
+                                                tri_pts, bvh_pad);
         }
         a(i,j,k) = (num_intersects % 2 == 0) ? reference_value : other_value;
     });
@@ -588,13 +861,13 @@ STLtools::getIntercept (Array<Array4<Real>,AMREX_SPACEDIM> const& inter_arr,
                         Array4<Real const> const& lst ,Geometry const& geom,
                         RunOn, Box const&) const
 {
-    int num_triangles = m_num_tri;
-
     const auto plo = geom.ProbLoArray();
     const auto dx  = geom.CellSizeArray();
 
     const Triangle* tri_pts = m_tri_pts_d.data();
     const XDim3* tri_norm = m_tri_normals_d.data();
+    const BVHNode* bvh_nodes = m_bvh_nodes_d.data();
+    const int* bvh_tri_ids = m_bvh_tri_ids_d.data();
 
     for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
         Array4<Real> const& inter = inter_arr[idim];
@@ -614,59 +887,29 @@ STLtools::getIntercept (Array<Array4<Real>,AMREX_SPACEDIM> const& inter_arr,
                 };
                 if (idim == 0) {
                     Real x2 = plo[0]+(i+1)*dx[0];
-                    int it;
-                    for (it=0; it < num_triangles; ++it) {
-                        auto const& tri = tri_pts[it];
-                        auto tmp = edge_tri_intersects(p1.x, x2, p1.y, p1.z,
-                                                       tri.v1, tri.v2, tri.v3,
-                                                       tri_norm[it],
-                                                       lst(i+1,j,k)-lst(i,j,k));
-                        if (tmp.first) {
-                            r = tmp.second;
-                            break;
-                        }
-                    }
-                    if (it == num_triangles) {
+                    auto tmp = bvh_edge_intersects(0, p1, x2, lst(i+1,j,k)-lst(i,j,k),
+                                                   bvh_nodes, bvh_tri_ids, tri_pts, tri_norm);
+                    if (tmp.first) {
+                        r = tmp.second;
+                    } else {
                         r = (lst(i,j,k) > 0._rt) ? p1.x : x2;
                     }
                 } else if (idim == 1) {
                     Real y2 = plo[1]+(j+1)*dx[1];
-                    int it;
-                    for (it=0; it < num_triangles; ++it) {
-                        auto const& tri = tri_pts[it];
-                        auto const& norm = tri_norm[it];
-                        auto tmp = edge_tri_intersects(p1.y, y2, p1.z, p1.x,
-                                                       {tri.v1.y, tri.v1.z, tri.v1.x},
-                                                       {tri.v2.y, tri.v2.z, tri.v2.x},
-                                                       {tri.v3.y, tri.v3.z, tri.v3.x},
-                                                       {  norm.y,   norm.z,   norm.x},
-                                                       lst(i,j+1,k)-lst(i,j,k));
-                        if (tmp.first) {
-                            r = tmp.second;
-                            break;
-                        }
-                    }
-                    if (it == num_triangles) {
+                    auto tmp = bvh_edge_intersects(1, p1, y2, lst(i,j+1,k)-lst(i,j,k),
+                                                   bvh_nodes, bvh_tri_ids, tri_pts, tri_norm);
+                    if (tmp.first) {
+                        r = tmp.second;
+                    } else {
                         r = (lst(i,j,k) > 0._rt) ? p1.y : y2;
                     }
                 } else {
                     Real z2 = plo[2]+(k+1)*dx[2];
-                    int it;
-                    for (it=0; it < num_triangles; ++it) {
-                        auto const& tri = tri_pts[it];
-                        auto const& norm = tri_norm[it];
-                        auto tmp = edge_tri_intersects(p1.z, z2, p1.x, p1.y,
-                                                       {tri.v1.z, tri.v1.x, tri.v1.y},
-                                                       {tri.v2.z, tri.v2.x, tri.v2.y},
-                                                       {tri.v3.z, tri.v3.x, tri.v3.y},
-                                                       {  norm.z,   norm.x,   norm.y},
-                                                       lst(i,j,k+1)-lst(i,j,k));
-                        if (tmp.first) {
-                            r = tmp.second;
-                            break;
-                        }
-                    }
-                    if (it == num_triangles) {
+                    auto tmp = bvh_edge_intersects(2, p1, z2, lst(i,j,k+1)-lst(i,j,k),
+                                                   bvh_nodes, bvh_tri_ids, tri_pts, tri_norm);
+                    if (tmp.first) {
+                        r = tmp.second;
+                    } else {
                         r = (lst(i,j,k) > 0._rt) ? p1.z : z2;
                     }
                 }
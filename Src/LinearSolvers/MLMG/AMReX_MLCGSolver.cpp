@@ -49,6 +49,55 @@ sxay (MultiFab&       ss,
     sxay(ss,xx,a,yy,0,nghost);
 }
 
+//
+// Global sums and maxima over the bottom communicator that are started by
+// start() and completed by wait(), so that the latency of the reductions
+// can be hidden behind a matvec.
+//
+class NonBlockingReduce
+{
+public:
+    explicit NonBlockingReduce (MPI_Comm a_comm) noexcept : comm(a_comm) {}
+    ~NonBlockingReduce () { wait(); }
+
+    NonBlockingReduce (const NonBlockingReduce&) = delete;
+    NonBlockingReduce& operator= (const NonBlockingReduce&) = delete;
+
+    void start (Real* sum, int nsum, Real* mx, int nmax)
+    {
+        wait();
+#ifdef BL_USE_MPI
+        const auto mpi_type = ParallelDescriptor::Mpi_typemap<Real>::type();
+        if (nsum > 0) {
+            MPI_Iallreduce(MPI_IN_PLACE, sum, nsum, mpi_type, MPI_SUM, comm, &reqs[nreqs++]);
+        }
+        if (nmax > 0) {
+            MPI_Iallreduce(MPI_IN_PLACE, mx, nmax, mpi_type, MPI_MAX, comm, &reqs[nreqs++]);
+        }
+#else
+        amrex::ignore_unused(sum,nsum,mx,nmax,comm);
+#endif
+    }
+
+    void wait ()
+    {
+#ifdef BL_USE_MPI
+        if (nreqs > 0) {
+            BL_PROFILE("MLCGSolver::ParallelAllReduce");
+            MPI_Waitall(nreqs, reqs, MPI_STATUSES_IGNORE);
+            nreqs = 0;
+        }
+#endif
+    }
+
+private:
+    MPI_Comm comm;
+#ifdef BL_USE_MPI
+    MPI_Request reqs[2];
+    int nreqs = 0;
+#endif
+};
+
 }
 
 MLCGSolver::MLCGSolver (MLMG* a_mlmg, MLLinOp& _lp, Type _typ)
@@ -71,9 +120,16 @@ MLCGSolver::solve (MultiFab&       sol,
                    Real            eps_rel,
                    Real            eps_abs)
 {
-    if (solver_type == Type::BiCGStab) {
+    switch (solver_type) {
+    case Type::BiCGStab:
         return solve_bicgstab(sol,rhs,eps_rel,eps_abs);
-    } else {
+    case Type::PipelinedCG:
+        return solve_pipelined_cg(sol,rhs,eps_rel,eps_abs);
+    case Type::PipelinedBiCGStab:
+        return solve_pipelined_bicgstab(sol,rhs,eps_rel,eps_abs);
+    case Type::SStepCG:
+        return solve_sstep_cg(sol,rhs,eps_rel,eps_abs);
+    default:
         return solve_cg(sol,rhs,eps_rel,eps_abs);
     }
 }
@@ -396,6 +452,617 @@ MLCGSolver::solve_cg (MultiFab&       sol,
     return ret;
 }
 
+int
+MLCGSolver::solve_pipelined_cg (MultiFab&       sol,
+                                const MultiFab& rhs,
+                                Real            eps_rel,
+                                Real            eps_abs)
+{
+    BL_PROFILE("MLCGSolver::pipelined_cg");
+
+    const int ncomp = sol.nComp();
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    const auto& factory = sol.Factory();
+
+    MultiFab w(ba, dm, ncomp, sol.nGrowVect(), MFInfo(), factory);
+    w.setVal(0.0);
+
+    MultiFab sorig(ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab r    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab p    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab s    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab z    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab m    (ba, dm, ncomp, nghost, MFInfo(), factory);
+
+    MultiFab::Copy(sorig,sol,0,0,ncomp,nghost);
+
+    Lp.correctionResidual(amrlev, mglev, r, sol, rhs, MLLinOp::BCMode::Homogeneous);
+
+    sol.setVal(0);
+
+    Real       rnorm    = norm_inf(r);
+    const Real rnorm0   = rnorm;
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_PipelinedCG: Initial error (error0) :        " << rnorm0 << '\n';
+    }
+
+    int ret = 0;
+    iter = 0;
+
+    if ( rnorm0 == 0 || rnorm0 < eps_abs )
+    {
+        if ( verbose > 0 ) {
+            amrex::Print() << "MLCGSolver_PipelinedCG: niter = 0,"
+                           << ", rnorm = " << rnorm
+                           << ", eps_abs = " << eps_abs << std::endl;
+        }
+        return ret;
+    }
+
+    // w = A r
+    MultiFab::Copy(w,r,0,0,ncomp,nghost);
+    Lp.apply(amrlev, mglev, m, w, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+    MultiFab::Copy(w,m,0,0,ncomp,nghost);
+
+    NonBlockingReduce reduce(Lp.BottomCommunicator());
+    Real gamma_1 = 0, alpha_1 = 0;
+
+    //
+    // The residual of the previous iteration is checked after the
+    // reduction that overlaps with m = A w has completed, so iter counts
+    // the updates of sol that have been done.
+    //
+    for (;; ++iter)
+    {
+        Real sums[2] = { dotxy(r,r,true), dotxy(w,r,true) };
+        rnorm = norm_inf(r,true);
+        reduce.start(sums, 2, &rnorm, 1);
+
+        Lp.apply(amrlev, mglev, m, w, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+
+        reduce.wait();
+
+        if ( iter > 0 )
+        {
+            if ( verbose > 2 )
+            {
+                amrex::Print() << "MLCGSolver_PipelinedCG: Iteration"
+                               << std::setw(4) << iter
+                               << " rel. err. "
+                               << rnorm/(rnorm0) << '\n';
+            }
+
+            if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
+        }
+
+        if ( iter == maxiter ) break;
+
+        const Real gamma = sums[0];
+        const Real delta = sums[1];
+        if ( gamma == 0 )
+        {
+            ret = 1; break;
+        }
+
+        Real beta, alpha;
+        if ( iter == 0 )
+        {
+            beta = 0;
+            if ( delta == Real(0.0) )
+            {
+                ret = 1; break;
+            }
+            alpha = gamma/delta;
+            MultiFab::Copy(z,m,0,0,ncomp,nghost);
+            MultiFab::Copy(s,w,0,0,ncomp,nghost);
+            MultiFab::Copy(p,r,0,0,ncomp,nghost);
+        }
+        else
+        {
+            beta = gamma/gamma_1;
+            const Real denom = delta - beta*gamma/alpha_1;
+            if ( denom == Real(0.0) )
+            {
+                ret = 1; break;
+            }
+            alpha = gamma/denom;
+            sxay(z, m, beta, z, nghost);
+            sxay(s, w, beta, s, nghost);
+            sxay(p, r, beta, p, nghost);
+        }
+
+        if ( verbose > 2 )
+        {
+            amrex::Print() << "MLCGSolver_PipelinedCG:"
+                           << " iter " << iter+1
+                           << " gamma " << gamma
+                           << " alpha " << alpha << '\n';
+        }
+
+        sxay(sol, sol, alpha, p, nghost);
+        sxay(  r,   r,-alpha, s, nghost);
+        sxay(  w,   w,-alpha, z, nghost);
+
+        gamma_1 = gamma;
+        alpha_1 = alpha;
+    }
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_PipelinedCG: Final Iteration"
+                       << std::setw(4) << iter
+                       << " rel. err. "
+                       << rnorm/(rnorm0) << '\n';
+    }
+
+    if ( ret == 0 &&  rnorm > eps_rel*rnorm0 && rnorm > eps_abs )
+    {
+        if ( verbose > 0 && ParallelDescriptor::IOProcessor() )
+            amrex::Warning("MLCGSolver_PipelinedCG: failed to converge!");
+        ret = 8;
+    }
+
+    if ( ( ret == 0 || ret == 8 ) && (rnorm < rnorm0) )
+    {
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+    else
+    {
+        sol.setVal(0);
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+
+    return ret;
+}
+
+int
+MLCGSolver::solve_pipelined_bicgstab (MultiFab&       sol,
+                                      const MultiFab& rhs,
+                                      Real            eps_rel,
+                                      Real            eps_abs)
+{
+    BL_PROFILE("MLCGSolver::pipelined_bicgstab");
+
+    const int ncomp = sol.nComp();
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    const auto& factory = sol.Factory();
+
+    // w and z are the inputs of the matvecs.
+    MultiFab w(ba, dm, ncomp, sol.nGrowVect(), MFInfo(), factory);
+    MultiFab z(ba, dm, ncomp, sol.nGrowVect(), MFInfo(), factory);
+    w.setVal(0.0);
+    z.setVal(0.0);
+
+    MultiFab sorig(ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab r    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab rh   (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab p    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab s    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab q    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab y    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab t    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab v    (ba, dm, ncomp, nghost, MFInfo(), factory);
+
+    auto matvec = [&] (MultiFab& out, MultiFab& in)
+    {
+        Lp.apply(amrlev, mglev, out, in, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        Lp.normalize(amrlev, mglev, out);
+    };
+
+    Lp.correctionResidual(amrlev, mglev, r, sol, rhs, MLLinOp::BCMode::Homogeneous);
+    Lp.normalize(amrlev, mglev, r);
+
+    MultiFab::Copy(sorig,sol,0,0,ncomp,nghost);
+    MultiFab::Copy(rh,   r,  0,0,ncomp,nghost);
+
+    sol.setVal(0);
+
+    Real rnorm = norm_inf(r);
+    const Real rnorm0   = rnorm;
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_PipelinedBiCGStab: Initial error (error0) =        " << rnorm0 << '\n';
+    }
+    int ret = 0;
+    iter = 1;
+
+    if ( rnorm0 == 0 || rnorm0 < eps_abs )
+    {
+        if ( verbose > 0 )
+        {
+            amrex::Print() << "MLCGSolver_PipelinedBiCGStab: niter = 0,"
+                           << ", rnorm = " << rnorm
+                           << ", eps_abs = " << eps_abs << std::endl;
+        }
+        return ret;
+    }
+
+    NonBlockingReduce reduce(Lp.BottomCommunicator());
+
+    // w = A r, t = A w
+    MultiFab::Copy(z,r,0,0,ncomp,nghost);
+    matvec(w, z);
+
+    Real rvals[4] = { dotxy(rh,r,true), dotxy(rh,w,true), 0, 0 };
+    reduce.start(rvals, 2, nullptr, 0);
+    matvec(t, w);
+    reduce.wait();
+
+    Real rho_1 = rvals[0];
+    if ( rho_1 == 0 || rvals[1] == Real(0.0) )
+    {
+        ret = 1;
+    }
+    Real alpha = (ret == 0) ? rho_1/rvals[1] : Real(0.0);
+    Real beta = 0, omega = 0;
+
+    for (; ret == 0 && iter <= maxiter; ++iter)
+    {
+        if ( iter == 1 )
+        {
+            MultiFab::Copy(p,r,0,0,ncomp,nghost);
+            MultiFab::Copy(s,w,0,0,ncomp,nghost);
+            MultiFab::Copy(z,t,0,0,ncomp,nghost);
+        }
+        else
+        {
+            sxay(p, p, -omega, s, nghost);
+            sxay(p, r,   beta, p, nghost);
+            sxay(s, s, -omega, z, nghost);
+            sxay(s, w,   beta, s, nghost);
+            sxay(z, z, -omega, v, nghost);
+            sxay(z, t,   beta, z, nghost);
+        }
+        sxay(q, r, -alpha, s, nghost);
+        sxay(y, w, -alpha, z, nghost);
+
+        Real qvals[2] = { dotxy(q,y,true), dotxy(y,y,true) };
+        rnorm = norm_inf(q,true);
+        reduce.start(qvals, 2, &rnorm, 1);
+        matvec(v, z);
+        reduce.wait();
+
+        if ( verbose > 2 )
+        {
+            amrex::Print() << "MLCGSolver_PipelinedBiCGStab: Half Iter "
+                           << std::setw(11) << iter
+                           << " rel. err. "
+                           << rnorm/(rnorm0) << '\n';
+        }
+
+        if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs )
+        {
+            sxay(sol, sol, alpha, p, nghost);
+            break;
+        }
+
+        if ( qvals[1] != Real(0.0) )
+        {
+            omega = qvals[0]/qvals[1];
+        }
+        else
+        {
+            ret = 3; break;
+        }
+
+        sxay(sol, sol, alpha, p, nghost);
+        sxay(sol, sol, omega, q, nghost);
+        sxay(r, q, -omega, y, nghost);
+        sxay(t, t, -alpha, v, nghost);
+        sxay(w, y, -omega, t, nghost);
+
+        rvals[0] = dotxy(rh,r,true);
+        rvals[1] = dotxy(rh,w,true);
+        rvals[2] = dotxy(rh,s,true);
+        rvals[3] = dotxy(rh,z,true);
+        rnorm = norm_inf(r,true);
+        reduce.start(rvals, 4, &rnorm, 1);
+        matvec(t, w);
+        reduce.wait();
+
+        if ( verbose > 2 )
+        {
+            amrex::Print() << "MLCGSolver_PipelinedBiCGStab: Iteration "
+                           << std::setw(11) << iter
+                           << " rel. err. "
+                           << rnorm/(rnorm0) << '\n';
+        }
+
+        if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
+
+        if ( omega == 0 )
+        {
+            ret = 4; break;
+        }
+
+        const Real rho = rvals[0];
+        if ( rho == 0 )
+        {
+            ret = 1; break;
+        }
+        beta = (rho/rho_1)*(alpha/omega);
+        const Real denom = rvals[1] + beta*rvals[2] - beta*omega*rvals[3];
+        if ( denom != Real(0.0) )
+        {
+            alpha = rho/denom;
+        }
+        else
+        {
+            ret = 2; break;
+        }
+        rho_1 = rho;
+    }
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_PipelinedBiCGStab: Final: Iteration "
+                       << std::setw(4) << iter
+                       << " rel. err. "
+                       << rnorm/(rnorm0) << '\n';
+    }
+
+    if ( ret == 0 && rnorm > eps_rel*rnorm0 && rnorm > eps_abs)
+    {
+        if ( verbose > 0 && ParallelDescriptor::IOProcessor() )
+            amrex::Warning("MLCGSolver_PipelinedBiCGStab:: failed to converge!");
+        ret = 8;
+    }
+
+    if ( ( ret == 0 || ret == 8 ) && (rnorm < rnorm0) )
+    {
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+    else
+    {
+        sol.setVal(0);
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+
+    return ret;
+}
+
+int
+MLCGSolver::solve_sstep_cg (MultiFab&       sol,
+                            const MultiFab& rhs,
+                            Real            eps_rel,
+                            Real            eps_abs)
+{
+    BL_PROFILE("MLCGSolver::sstep_cg");
+
+    const int ncomp = sol.nComp();
+    const int ns = std::max(sstep, 1);
+    const int nb = 2*ns+1;
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    const auto& factory = sol.Factory();
+
+    //
+    // The basis is Y = [P_0, ..., P_s, R_0, ..., R_{s-1}] with P_0 = p,
+    // R_0 = r, and P_{j+1} = A P_j / sigma, R_{j+1} = A R_j / sigma.
+    // Every basis vector is the input of a matvec.
+    //
+    Vector<MultiFab> Y(nb);
+    for (auto& mf : Y) {
+        mf.define(ba, dm, ncomp, sol.nGrowVect(), MFInfo(), factory);
+        mf.setVal(0.0);
+    }
+
+    MultiFab sorig(ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab r    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab p    (ba, dm, ncomp, nghost, MFInfo(), factory);
+
+    MultiFab::Copy(sorig,sol,0,0,ncomp,nghost);
+
+    Lp.correctionResidual(amrlev, mglev, r, sol, rhs, MLLinOp::BCMode::Homogeneous);
+
+    sol.setVal(0);
+
+    Real       rnorm    = norm_inf(r);
+    const Real rnorm0   = rnorm;
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_SStepCG: Initial error (error0) :        " << rnorm0 << '\n';
+    }
+
+    int ret = 0;
+    iter = 0;
+
+    if ( rnorm0 == 0 || rnorm0 < eps_abs )
+    {
+        if ( verbose > 0 ) {
+            amrex::Print() << "MLCGSolver_SStepCG: niter = 0,"
+                           << ", rnorm = " << rnorm
+                           << ", eps_abs = " << eps_abs << std::endl;
+        }
+        return ret;
+    }
+
+    NonBlockingReduce reduce(Lp.BottomCommunicator());
+
+    // Estimate |A| so that the monomial basis neither grows nor decays.
+    Real sigma;
+    {
+        MultiFab::Copy(Y[0],r,0,0,ncomp,nghost);
+        Lp.apply(amrlev, mglev, Y[1], Y[0], MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        Real vals[2] = { dotxy(Y[1],Y[1],true), dotxy(Y[0],Y[0],true) };
+        reduce.start(vals, 2, nullptr, 0);
+        reduce.wait();
+        sigma = (vals[0] > 0 && vals[1] > 0) ? std::sqrt(vals[0]/vals[1]) : Real(1.0);
+    }
+
+    MultiFab::Copy(p,r,0,0,ncomp,nghost);
+
+    const int ngram = nb*(nb+1)/2;
+    Vector<Real> gram(ngram);
+    Vector<Real> G(nb*nb);
+    Vector<Real> xc(nb), rc(nb), pc(nb), Bp(nb);
+
+    auto gdot = [&] (const Vector<Real>& a, const Vector<Real>& b)
+    {
+        Real result = 0;
+        for (int i = 0; i < nb; ++i) {
+            for (int j = 0; j < nb; ++j) {
+                result += a[i]*G[i*nb+j]*b[j];
+            }
+        }
+        return result;
+    };
+
+    // A Y c = Y B c
+    auto bmul = [&] (const Vector<Real>& a, Vector<Real>& b)
+    {
+        std::fill(b.begin(), b.end(), Real(0.0));
+        for (int j = 0; j < ns; ++j) {
+            b[j+1] = sigma*a[j];
+        }
+        for (int j = 0; j < ns-1; ++j) {
+            b[ns+2+j] = sigma*a[ns+1+j];
+        }
+    };
+
+    auto combine = [&] (MultiFab& dst, const Vector<Real>& c, bool accumulate)
+    {
+        if (!accumulate) dst.setVal(0.0, 0, ncomp, nghost);
+        for (int k = 0; k < nb; ++k) {
+            if (c[k] != Real(0.0)) {
+                MultiFab::Saxpy(dst, c[k], Y[k], 0, 0, ncomp, nghost);
+            }
+        }
+    };
+
+    for (;;)
+    {
+        MultiFab::Copy(Y[0],   p,0,0,ncomp,nghost);
+        MultiFab::Copy(Y[ns+1],r,0,0,ncomp,nghost);
+        for (int j = 0; j < ns; ++j) {
+            Lp.apply(amrlev, mglev, Y[j+1], Y[j], MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+            Y[j+1].mult(Real(1.0)/sigma, 0, ncomp, nghost);
+        }
+        for (int j = 0; j < ns-1; ++j) {
+            Lp.apply(amrlev, mglev, Y[ns+2+j], Y[ns+1+j], MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+            Y[ns+2+j].mult(Real(1.0)/sigma, 0, ncomp, nghost);
+        }
+
+        int k = 0;
+        for (int i = 0; i < nb; ++i) {
+            for (int j = i; j < nb; ++j) {
+                gram[k++] = dotxy(Y[i],Y[j],true);
+            }
+        }
+        rnorm = norm_inf(r,true);
+        reduce.start(gram.data(), ngram, &rnorm, 1);
+        reduce.wait();
+
+        k = 0;
+        for (int i = 0; i < nb; ++i) {
+            for (int j = i; j < nb; ++j) {
+                G[i*nb+j] = G[j*nb+i] = gram[k++];
+            }
+        }
+
+        if ( iter > 0 )
+        {
+            if ( verbose > 2 )
+            {
+                amrex::Print() << "MLCGSolver_SStepCG: Iteration"
+                               << std::setw(4) << iter
+                               << " rel. err. "
+                               << rnorm/(rnorm0) << '\n';
+            }
+
+            if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
+        }
+
+        if ( iter >= maxiter ) break;
+
+        std::fill(xc.begin(), xc.end(), Real(0.0));
+        std::fill(rc.begin(), rc.end(), Real(0.0));
+        std::fill(pc.begin(), pc.end(), Real(0.0));
+        rc[ns+1] = 1;
+        pc[0] = 1;
+
+        Real rho = gdot(rc,rc);
+        if ( rho <= 0 )
+        {
+            ret = 1; break;
+        }
+
+        for (int j = 0; j < ns && iter < maxiter; ++j, ++iter)
+        {
+            bmul(pc, Bp);
+            const Real pw = gdot(pc, Bp);
+            if ( pw == Real(0.0) )
+            {
+                ret = (j == 0) ? 1 : 0;
+                break;
+            }
+            const Real alpha = rho/pw;
+            for (int i = 0; i < nb; ++i) {
+                xc[i] += alpha*pc[i];
+                rc[i] -= alpha*Bp[i];
+            }
+            const Real rho_new = gdot(rc,rc);
+            if ( rho_new <= Real(0.0) ) {
+                // The residual is below what the Gram matrix can resolve.
+                ++iter;
+                std::fill(pc.begin(), pc.end(), Real(0.0));
+                break;
+            }
+            const Real beta = rho_new/rho;
+            for (int i = 0; i < nb; ++i) {
+                pc[i] = rc[i] + beta*pc[i];
+            }
+            rho = rho_new;
+        }
+        if ( ret != 0 ) break;
+
+        combine(sol, xc, true);
+        combine(r, rc, false);
+        combine(p, pc, false);
+
+        // Rescale the basis with the growth of the previous one.
+        if ( G[0] > 0 && G[nb+1] > 0 ) {
+            sigma *= std::sqrt(G[nb+1]/G[0]);
+        }
+    }
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_SStepCG: Final Iteration"
+                       << std::setw(4) << iter
+                       << " rel. err. "
+                       << rnorm/(rnorm0) << '\n';
+    }
+
+    if ( ret == 0 &&  rnorm > eps_rel*rnorm0 && rnorm > eps_abs )
+    {
+        if ( verbose > 0 && ParallelDescriptor::IOProcessor() )
+            amrex::Warning("MLCGSolver_SStepCG: failed to converge!");
+        ret = 8;
+    }
+
+    if ( ( ret == 0 || ret == 8 ) && (rnorm < rnorm0) )
+    {
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+    else
+    {
+        sol.setVal(0);
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+
+    return ret;
+}
+
 Real
 MLCGSolver::dotxy (const MultiFab& r, const MultiFab& z, bool local)
 {
@@ -776,6 +776,207 @@ MLCellLinOp::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, State
     }
 }
 
+void
+MLCellLinOp::smoothSP (int amrlev, int mglev, fMultiFab& sol, const fMultiFab& rhs,
+                       bool skip_fillboundary) const
+{
+    BL_PROFILE("MLCellLinOp::smoothSP()");
+    for (int redblack = 0; redblack < 2; ++redblack)
+    {
+        applyBCSP(amrlev, mglev, sol, skip_fillboundary);
+        FsmoothSP(amrlev, mglev, sol, rhs, redblack);
+        skip_fillboundary = false;
+    }
+}
+
+void
+MLCellLinOp::correctionResidualSP (int amrlev, int mglev, fMultiFab& resid, fMultiFab& x,
+                                   const fMultiFab& b) const
+{
+    BL_PROFILE("MLCellLinOp::correctionResidualSP()");
+    const int ncomp = getNComp();
+
+    applyBCSP(amrlev, mglev, x);
+    FapplySP(amrlev, mglev, resid, x);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(resid,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        Array4<float> const& rfab = resid.array(mfi);
+        Array4<float const> const& bfab = b.const_array(mfi);
+        AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+        {
+            rfab(i,j,k,n) = bfab(i,j,k,n) - rfab(i,j,k,n);
+        });
+    }
+}
+
+void
+MLCellLinOp::restrictionSP (int amrlev, int cmglev, fMultiFab& crse, fMultiFab& fine) const
+{
+    BL_PROFILE("MLCellLinOp::restrictionSP()");
+    const int ncomp = getNComp();
+    IntVect ratio = (amrlev > 0) ? IntVect(2) : mg_coarsen_ratio_vec[cmglev-1];
+
+    // With agglomeration the coarse MG grids are not the coarsened fine
+    // grids, so we average down onto the fine layout first.
+    BoxArray cba = fine.boxArray();
+    cba.coarsen(ratio);
+    const bool is_local = cba == crse.boxArray()
+        && crse.DistributionMap() == fine.DistributionMap();
+    fMultiFab cfine;
+    if (!is_local) {
+        cfine.define(cba, fine.DistributionMap(), ncomp, 0);
+    }
+    fMultiFab& cmf = is_local ? crse : cfine;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(cmf,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        Array4<float> const& cfab = cmf.array(mfi);
+        Array4<float const> const& ffab = fine.const_array(mfi);
+        AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+        {
+            amrex_avgdown(i,j,k,n,cfab,ffab,0,0,ratio);
+        });
+    }
+
+    if (!is_local) {
+        crse.ParallelCopy(cfine, 0, 0, ncomp);
+    }
+}
+
+void
+MLCellLinOp::interpolationSP (int amrlev, int fmglev, fMultiFab& fine, const fMultiFab& crse) const
+{
+    BL_PROFILE("MLCellLinOp::interpolationSP()");
+    const int ncomp = getNComp();
+
+    Dim3 ratio3 = {2,2,2};
+    IntVect ratio = (amrlev > 0) ? IntVect(2) : mg_coarsen_ratio_vec[fmglev];
+    AMREX_D_TERM(ratio3.x = ratio[0];,
+                 ratio3.y = ratio[1];,
+                 ratio3.z = ratio[2];);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(fine,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        Array4<float const> const& cfab = crse.const_array(mfi);
+        Array4<float> const& ffab = fine.array(mfi);
+        AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+        {
+            int ic = amrex::coarsen(i,ratio3.x);
+            int jc = amrex::coarsen(j,ratio3.y);
+            int kc = amrex::coarsen(k,ratio3.z);
+            ffab(i,j,k,n) += cfab(ic,jc,kc,n);
+        });
+    }
+}
+
+void
+MLCellLinOp::applyBCSP (int amrlev, int mglev, fMultiFab& in, bool skip_fillboundary) const
+{
+    BL_PROFILE("MLCellLinOp::applyBCSP()");
+    AMREX_ALWAYS_ASSERT(isCrossStencil());
+
+    const int ncomp = getNComp();
+    if (!skip_fillboundary) {
+        in.FillBoundary(0, ncomp, m_geom[amrlev][mglev].periodicity(), true);
+    }
+
+    const int flagbc = 0;
+    const int imaxorder = maxorder;
+
+    const Real* dxinv = m_geom[amrlev][mglev].InvCellSize();
+    const Real dxi = dxinv[0];
+    const Real dyi = (AMREX_SPACEDIM >= 2) ? dxinv[1] : Real(1.0);
+    const Real dzi = (AMREX_SPACEDIM == 3) ? dxinv[2] : Real(1.0);
+
+    const auto& maskvals = m_maskvals[amrlev][mglev];
+    const auto& bcondloc = *m_bcondloc[amrlev][mglev];
+
+    // Boundary values are not used with homogeneous BC.
+    const Array4<float const> foo;
+
+    const int hidden_direction = hiddenDirection();
+
+    MFItInfo mfi_info;
+    if (Gpu::notInLaunchRegion()) mfi_info.SetDynamic(true);
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(in, mfi_info); mfi.isValid(); ++mfi)
+    {
+        const Box& vbx   = mfi.validbox();
+        const auto& iofab = in.array(mfi);
+
+        const auto & bdlv = bcondloc.bndryLocs(mfi);
+        const auto & bdcv = bcondloc.bndryConds(mfi);
+
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+        {
+            if (hidden_direction == idim) continue;
+            const Orientation olo(idim,Orientation::low);
+            const Orientation ohi(idim,Orientation::high);
+            const Box blo = amrex::adjCellLo(vbx, idim);
+            const Box bhi = amrex::adjCellHi(vbx, idim);
+            const int blen = vbx.length(idim);
+            const auto& mlo = maskvals[olo].array(mfi);
+            const auto& mhi = maskvals[ohi].array(mfi);
+            for (int icomp = 0; icomp < ncomp; ++icomp) {
+                const BoundCond bctlo = bdcv[icomp][olo];
+                const BoundCond bcthi = bdcv[icomp][ohi];
+                const Real bcllo = bdlv[icomp][olo];
+                const Real bclhi = bdlv[icomp][ohi];
+                if (idim == 0) {
+                    AMREX_HOST_DEVICE_PARALLEL_FOR_3D(blo, i, j, k,
+                    {
+                        mllinop_apply_bc_x(0, i, j, k, blen, iofab, mlo, bctlo, bcllo, foo,
+                                           imaxorder, dxi, flagbc, icomp);
+                    });
+                    AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bhi, i, j, k,
+                    {
+                        mllinop_apply_bc_x(1, i, j, k, blen, iofab, mhi, bcthi, bclhi, foo,
+                                           imaxorder, dxi, flagbc, icomp);
+                    });
+                } else if (idim == 1) {
+                    AMREX_HOST_DEVICE_PARALLEL_FOR_3D(blo, i, j, k,
+                    {
+                        mllinop_apply_bc_y(0, i, j, k, blen, iofab, mlo, bctlo, bcllo, foo,
+                                           imaxorder, dyi, flagbc, icomp);
+                    });
+                    AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bhi, i, j, k,
+                    {
+                        mllinop_apply_bc_y(1, i, j, k, blen, iofab, mhi, bcthi, bclhi, foo,
+                                           imaxorder, dyi, flagbc, icomp);
+                    });
+                } else {
+                    AMREX_HOST_DEVICE_PARALLEL_FOR_3D(blo, i, j, k,
+                    {
+                        mllinop_apply_bc_z(0, i, j, k, blen, iofab, mlo, bctlo, bcllo, foo,
+                                           imaxorder, dzi, flagbc, icomp);
+                    });
+                    AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bhi, i, j, k,
+                    {
+                        mllinop_apply_bc_z(1, i, j, k, blen, iofab, mhi, bcthi, bclhi, foo,
+                                           imaxorder, dzi, flagbc, icomp);
+                    });
+                }
+            }
+        }
+    }
+}
+
 void
 MLCellLinOp::reflux (int crse_amrlev,
                      MultiFab& res, const MultiFab& crse_sol, const MultiFab&,
@@ -35,6 +35,7 @@ namespace {
     int consolidation_threshold = -1;
     int consolidation_ratio = 2;
     int consolidation_strategy = 3;
+    int min_npts_per_rank = -1;
 
     int flag_verbose_linop = 0;
     int flag_comm_cache = 0;
@@ -98,6 +99,7 @@ void MLLinOp::Initialize ()
     pp.queryAdd("consolidation_threshold", consolidation_threshold);
     pp.queryAdd("consolidation_ratio", consolidation_ratio);
     pp.queryAdd("consolidation_strategy", consolidation_strategy);
+    pp.queryAdd("min_npts_per_rank", min_npts_per_rank);
     pp.queryAdd("verbose_linop", flag_verbose_linop);
     pp.queryAdd("comm_cache", flag_comm_cache);
     pp.queryAdd("mota", flag_use_mota);
@@ -484,12 +486,21 @@ MLLinOp::defineGrids (const Vector<Geometry>& a_geom,
         makeConsolidatedDMap(m_grids[0], m_dmap[0], consolidation_ratio, consolidation_strategy);
     }
 
-    if (flag_use_mota && (agged || coned))
+    if (info.min_npts_per_rank <= 0) {
+        info.min_npts_per_rank = min_npts_per_rank;
+    }
+    bool shrunk = false;
+    if (info.min_npts_per_rank > 0)
+    {
+        shrunk = makeShrunkDMap(m_grids[0], m_dmap[0], info.min_npts_per_rank);
+    }
+
+    if (flag_use_mota && (agged || coned || shrunk))
     {
         remapNeighborhoods(m_dmap[0]);
     }
 
-    if (agged || coned)
+    if (agged || coned || shrunk)
     {
         m_bottom_comm = makeSubCommunicator(m_dmap[0].back());
     }
@@ -512,6 +523,14 @@ MLLinOp::defineGrids (const Vector<Geometry>& a_geom,
         } else {
             Print() << "MLLinOp::defineGrids(): no agglomeration or consolidation of AMR level 0" << std::endl;
         }
+        if (shrunk) {
+            Print() << "MLLinOp::defineGrids(): number of ranks on MG levels of AMR level 0:";
+            for (auto const& dm : m_dmap[0]) {
+                std::set<int> ranks(dm.ProcessorMap().begin(), dm.ProcessorMap().end());
+                Print() << " " << ranks.size();
+            }
+            Print() << std::endl;
+        }
     }
 
     for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
@@ -812,6 +831,51 @@ MLLinOp::makeConsolidatedDMap (const Vector<BoxArray>& ba, Vector<DistributionMa
     }
 }
 
+bool
+MLLinOp::makeShrunkDMap (const Vector<BoxArray>& ba, Vector<DistributionMapping>& dm,
+                         Long npts_per_rank)
+{
+    BL_PROFILE("MLLinOp::makeShrunkDMap()");
+
+    bool shrunk = false;
+    BL_ASSERT(!dm[0].empty());
+    for (int i = 1, N=ba.size(); i < N; ++i)
+    {
+        const auto& pmap_fine = dm[i-1].ProcessorMap();
+        Vector<int> ranks_fine(pmap_fine.begin(), pmap_fine.end());
+        std::sort(ranks_fine.begin(), ranks_fine.end());
+        ranks_fine.erase(std::unique(ranks_fine.begin(), ranks_fine.end()), ranks_fine.end());
+        const int nranks_fine = ranks_fine.size();
+
+        const Long nranks_work = std::max(ba[i].numPts() / npts_per_rank, Long(1));
+        const int nranks = static_cast<int>(std::min({nranks_work, Long(nranks_fine),
+                                                      Long(ba[i].size())}));
+
+        // Keep the map if it already uses at most nranks of the fine ranks.
+        std::set<int> ranks(dm[i].ProcessorMap().begin(), dm[i].ProcessorMap().end());
+        bool keep = static_cast<int>(ranks.size()) <= nranks;
+        for (int rank : ranks) {
+            keep = keep && std::binary_search(ranks_fine.begin(), ranks_fine.end(), rank);
+        }
+        if (keep) { continue; }
+
+        // Spread the coarse ranks evenly over the fine ranks so that
+        // the ranks of each level are a subset of those of the finer one.
+        const std::vector< std::vector<int> >& sfc = DistributionMapping::makeSFC(ba[i], true, nranks);
+        Vector<int> pmap(ba[i].size());
+        for (int iproc = 0; iproc < nranks; ++iproc) {
+            const int grank = ranks_fine[(Long(iproc)*nranks_fine)/nranks];
+            for (int ibox : sfc[iproc]) {
+                pmap[ibox] = grank;
+            }
+        }
+        // dm[i] may share its map with the finer levels, so do not define it in place.
+        dm[i] = DistributionMapping(std::move(pmap));
+        shrunk = true;
+    }
+    return shrunk;
+}
+
 void
 MLLinOp::remapNeighborhoods (Vector<DistributionMapping> & dms)
 {
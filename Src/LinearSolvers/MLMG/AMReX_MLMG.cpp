@@ -39,6 +39,28 @@
 
 namespace amrex {
 
+namespace {
+    // Copy between double and single precision data
+    template <class DMF, class SMF>
+    void mlmg_copy_precision (DMF& dst, SMF const& src, int ncomp, IntVect const& nghost)
+    {
+        using T = typename DMF::value_type;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+        for (MFIter mfi(dst,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.growntilebox(nghost);
+            auto const& d = dst.array(mfi);
+            auto const& s = src.const_array(mfi);
+            AMREX_HOST_DEVICE_PARALLEL_FOR_4D(bx, ncomp, i, j, k, n,
+            {
+                d(i,j,k,n) = static_cast<T>(s(i,j,k,n));
+            });
+        }
+    }
+}
+
 MLMG::MLMG (MLLinOp& a_lp)
     : linop(a_lp),
       namrlevs(a_lp.NAMRLevels()),
@@ -257,7 +279,15 @@ void MLMG::oneIter (int iter)
             makeSolvable(0,0,res[0][0]);
         }
 
-        if (iter < max_fmg_iters) {
+        if (use_mixed_precision) {
+            mlmg_copy_precision(sp_res[0], res[0][0], ncomp, IntVect(0));
+            if (iter < max_fmg_iters) {
+                mgFcycleSP();
+            } else {
+                mgVcycleSP(0);
+            }
+            mlmg_copy_precision(*cor[0][0], *sp_cor[0], ncomp, cor[0][0]->nGrowVect());
+        } else if (iter < max_fmg_iters) {
             mgFcycle ();
         } else {
             mgVcycle (0, 0);
@@ -557,6 +587,180 @@ MLMG::mgFcycle ()
     }
 }
 
+// Single precision version of mgVcycle on the coarsest AMR level.
+// in   : Residual (sp_res)
+// out  : Correction (sp_cor) from bottom to this function's local top
+void
+MLMG::mgVcycleSP (int mglev_top)
+{
+    BL_PROFILE("MLMG::mgVcycleSP()");
+
+    const int amrlev = 0;
+    const int mglev_bottom = linop.NMGLevels(amrlev) - 1;
+
+    for (int mglev = mglev_top; mglev < mglev_bottom; ++mglev)
+    {
+        BL_PROFILE_VAR("MLMG::mgVcycleSP_down::"+std::to_string(mglev), blp_mgv_down_lev);
+
+        sp_cor[mglev]->setVal(0.0f);
+        bool skip_fillboundary = true;
+        for (int i = 0; i < nu1; ++i) {
+            linop.smoothSP(amrlev, mglev, *sp_cor[mglev], sp_res[mglev], skip_fillboundary);
+            skip_fillboundary = false;
+        }
+
+        // rescor = res - L(cor)
+        linop.correctionResidualSP(amrlev, mglev, sp_rescor[mglev], *sp_cor[mglev], sp_res[mglev]);
+
+        // res_crse = R(rescor_fine); this provides res/b to the level below
+        linop.restrictionSP(amrlev, mglev+1, sp_res[mglev+1], sp_rescor[mglev]);
+    }
+
+    BL_PROFILE_VAR("MLMG::mgVcycleSP_bottom", blp_bottom);
+    bottomSolveSP();
+    BL_PROFILE_VAR_STOP(blp_bottom);
+
+    for (int mglev = mglev_bottom-1; mglev >= mglev_top; --mglev)
+    {
+        BL_PROFILE_VAR("MLMG::mgVcycleSP_up::"+std::to_string(mglev), blp_mgv_up_lev);
+        // cor_fine += I(cor_crse)
+        addInterpCorrectionSP(mglev);
+        for (int i = 0; i < nu2; ++i) {
+            linop.smoothSP(amrlev, mglev, *sp_cor[mglev], sp_res[mglev]);
+        }
+    }
+}
+
+// Single precision version of mgFcycle.
+// in:  Residual on the top MG level (sp_res[0])
+// out: Correction (sp_cor) on all MG levels
+void
+MLMG::mgFcycleSP ()
+{
+    BL_PROFILE("MLMG::mgFcycleSP()");
+
+    const int amrlev = 0;
+    const int mg_bottom_lev = linop.NMGLevels(amrlev) - 1;
+    const int ncomp = linop.getNComp();
+
+    for (int mglev = 1; mglev <= mg_bottom_lev; ++mglev)
+    {
+        linop.restrictionSP(amrlev, mglev, sp_res[mglev], sp_res[mglev-1]);
+    }
+
+    bottomSolveSP();
+
+    for (int mglev = mg_bottom_lev-1; mglev >= 0; --mglev)
+    {
+        // cor_fine = I(cor_crse)
+        interpCorrectionSP(mglev);
+
+        // rescor = res - L(cor)
+        linop.correctionResidualSP(amrlev, mglev, sp_rescor[mglev], *sp_cor[mglev], sp_res[mglev]);
+        // res = rescor; this provides b to the vcycle below
+        amrex::Copy(sp_res[mglev], sp_rescor[mglev], 0, 0, ncomp, 0);
+
+        // save cor; do v-cycle; add the saved to cor
+        std::swap(sp_cor[mglev], sp_cor_hold[mglev]);
+        mgVcycleSP(mglev);
+        amrex::Add(*sp_cor[mglev], *sp_cor_hold[mglev], 0, 0, ncomp, 0);
+    }
+}
+
+// The bottom solve of the mixed-precision cycles is done in double precision.
+// in  : Residual (sp_res) on the bottom MG level
+// out : Correction (sp_cor) on the bottom MG level
+void
+MLMG::bottomSolveSP ()
+{
+    const int ncomp = linop.getNComp();
+    const int mglev_bottom = linop.NMGLevels(0) - 1;
+    mlmg_copy_precision(res[0][mglev_bottom], sp_res[mglev_bottom], ncomp, IntVect(0));
+    bottomSolve();
+    mlmg_copy_precision(*sp_cor[mglev_bottom], *cor[0][mglev_bottom], ncomp,
+                        cor[0][mglev_bottom]->nGrowVect());
+}
+
+// (Fine MG level correction) = I(Coarse MG level correction) in single precision
+void
+MLMG::interpCorrectionSP (int mglev)
+{
+    BL_PROFILE("MLMG::interpCorrectionSP()");
+
+    fMultiFab& crse_cor = *sp_cor[mglev+1];
+    fMultiFab& fine_cor = *sp_cor[mglev  ];
+
+    const int ncomp = linop.getNComp();
+
+    const Geometry& crse_geom = linop.Geom(0,mglev+1);
+    const IntVect refratio = linop.mg_coarsen_ratio_vec[mglev];
+
+    fMultiFab cfine;
+    const fMultiFab* cmf;
+
+    if (amrex::isMFIterSafe(crse_cor, fine_cor))
+    {
+        crse_cor.FillBoundary(crse_geom.periodicity());
+        cmf = &crse_cor;
+    }
+    else
+    {
+        BoxArray cba = fine_cor.boxArray();
+        cba.coarsen(refratio);
+        const IntVect& ng = crse_cor.nGrowVect();
+        cfine.define(cba, fine_cor.DistributionMap(), ncomp, ng);
+        cfine.setVal(0.0f);
+        cfine.ParallelCopy(crse_cor, 0, 0, ncomp, IntVect(0), ng, crse_geom.periodicity());
+        cmf = &cfine;
+    }
+
+    MFItInfo mfi_info;
+    if (Gpu::notInLaunchRegion()) mfi_info.EnableTiling().SetDynamic(true);
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(fine_cor, mfi_info); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        Array4<float> const& ff = fine_cor.array(mfi);
+        Array4<float const> const& cc = cmf->const_array(mfi);
+        AMREX_LAUNCH_HOST_DEVICE_LAMBDA (bx, tbx,
+        {
+            mlmg_lin_cc_interp_r2(tbx, ff, cc, ncomp);
+        });
+    }
+}
+
+// (Fine MG level correction) += I(Coarse MG level correction) in single precision
+void
+MLMG::addInterpCorrectionSP (int mglev)
+{
+    BL_PROFILE("MLMG::addInterpCorrectionSP()");
+
+    const int ncomp = linop.getNComp();
+
+    const fMultiFab& crse_cor = *sp_cor[mglev+1];
+    fMultiFab&       fine_cor = *sp_cor[mglev  ];
+
+    fMultiFab cfine;
+    const fMultiFab* cmf;
+
+    if (amrex::isMFIterSafe(crse_cor, fine_cor))
+    {
+        cmf = &crse_cor;
+    }
+    else
+    {
+        BoxArray cba = fine_cor.boxArray();
+        cba.coarsen(linop.mg_coarsen_ratio_vec[mglev]);
+        cfine.define(cba, fine_cor.DistributionMap(), ncomp, 0);
+        cfine.ParallelCopy(crse_cor);
+        cmf = &cfine;
+    }
+
+    linop.interpolationSP(0, mglev, fine_cor, *cmf);
+}
+
 // Interpolate correction from coarse to fine AMR level.
 void
 MLMG::interpCorrection (int alev)
@@ -967,6 +1171,12 @@ MLMG::actualBottomSolve ()
             if (bottom_solver == BottomSolver::cg ||
                 bottom_solver == BottomSolver::cgbicg) {
                 cg_type = MLCGSolver::Type::CG;
+            } else if (bottom_solver == BottomSolver::pipelinedcg) {
+                cg_type = MLCGSolver::Type::PipelinedCG;
+            } else if (bottom_solver == BottomSolver::pipelinedbicgstab) {
+                cg_type = MLCGSolver::Type::PipelinedBiCGStab;
+            } else if (bottom_solver == BottomSolver::sstepcg) {
+                cg_type = MLCGSolver::Type::SStepCG;
             } else {
                 cg_type = MLCGSolver::Type::BiCGStab;
             }
@@ -1012,6 +1222,7 @@ MLMG::bottomSolveWithCG (MultiFab& x, const MultiFab& b, MLCGSolver::Type type)
     cg_solver.setSolver(type);
     cg_solver.setVerbose(bottom_verbose);
     cg_solver.setMaxIter(bottom_maxiter);
+    cg_solver.setSStep(bottom_sstep);
     if (cf_strategy == CFStrategy::ghostnodes) cg_solver.setNGhost(linop.getNGrow());
 
     int ret = cg_solver.solve(x, b, bottom_reltol, bottom_abstol);
@@ -1302,6 +1513,29 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
         cor_hold[alev][0]->setVal(0.0);
     }
 
+    use_mixed_precision = mixed_precision && linop.supportMixedPrecision()
+        && linop.isCellCentered() && linop.NMGLevels(0) > 1
+        && cf_strategy != CFStrategy::ghostnodes;
+    if (use_mixed_precision && sp_res.empty())
+    {
+        const int nmglevs = linop.NMGLevels(0);
+        sp_res.resize(nmglevs);
+        sp_rescor.resize(nmglevs);
+        sp_cor.resize(nmglevs);
+        sp_cor_hold.resize(nmglevs);
+        for (int mglev = 0; mglev < nmglevs; ++mglev)
+        {
+            const BoxArray& ba = res[0][mglev].boxArray();
+            const DistributionMapping& dm = res[0][mglev].DistributionMap();
+            sp_res[mglev].define(ba, dm, ncomp, 0);
+            sp_rescor[mglev].define(ba, dm, ncomp, 0);
+            sp_cor[mglev] = std::make_unique<fMultiFab>(ba, dm, ncomp, ng);
+            if (mglev < nmglevs-1) {
+                sp_cor_hold[mglev] = std::make_unique<fMultiFab>(ba, dm, ncomp, ng);
+            }
+        }
+    }
+
     buildFineMask();
 
     if (!solve_called)
@@ -1,4 +1,5 @@
 #include <AMReX_ParticleCommunication.H>
+#include <AMReX_ParticleMPIUtil.H>
 #include <AMReX_ParallelDescriptor.H>
 
 using namespace amrex;
@@ -262,6 +263,12 @@ void ParticleCopyPlan::doHandShake (const Vector<Long>& Snds, Vector<Long>& Rcvs
 void ParticleCopyPlan::doHandShakeLocal (const Vector<Long>& Snds, Vector<Long>& Rcvs) const
 {
 #ifdef AMREX_USE_MPI
+    if (m_neighbor_comm != MPI_COMM_NULL)
+    {
+        exchangeNeighborCounts(m_neighbor_procs, m_neighbor_comm, Snds, Rcvs);
+        return;
+    }
+
     const int SeqNum = ParallelDescriptor::SeqNum();
     const int num_rcvs = m_neighbor_procs.size();
     Vector<MPI_Status>  stats(num_rcvs);
@@ -10,6 +10,12 @@ using namespace amrex;
 bool    ParticleContainerBase::do_tiling = false;
 IntVect ParticleContainerBase::tile_size { AMREX_D_DECL(1024000,8,8) };
 bool    ParticleContainerBase::memEfficientSort = true;
+bool    ParticleContainerBase::maintainCellSort = false;
+bool    ParticleContainerBase::coloredDeposition = false;
+bool    ParticleContainerBase::useNeighborCollectives = false;
+bool    ParticleContainerBase::chunkedCheckpoint = false;
+bool    ParticleContainerBase::compressCheckpoint = true;
+int     ParticleContainerBase::checkpointChunkSize = 65536;
 
 void ParticleContainerBase::Define (const Geometry            & geom,
                                     const DistributionMapping & dmap,
@@ -150,6 +156,18 @@ const std::string& ParticleContainerBase::CheckpointVersion ()
     return checkpoint_version;
 }
 
+const std::string& ParticleContainerBase::ChunkedCheckpointVersion ()
+{
+    //
+    // Written instead of CheckpointVersion() if particles.use_chunked_checkpoint
+    // is true.  The particles of each grid are stored as chunks of columns,
+    // indexed by the Particle_I file of each level.
+    //
+    static const std::string chunked_checkpoint_version("Version_Three_Dot_Zero");
+
+    return chunked_checkpoint_version;
+}
+
 const std::string& ParticleContainerBase::PlotfileVersion ()
 {
     //
@@ -222,6 +240,31 @@ Long ParticleContainerBase::MaxParticlesPerRead ()
     return Max_Particles_Per_Read;
 }
 
+Long ParticleContainerBase::InitMemoryBudget ()
+{
+    //
+    // This is roughly how many bytes each reader may use for the particles
+    // it has read but not yet handed off in InitFromBinaryFile().
+    //
+    const Long Init_Memory_Budget_def = 256*1024*1024;
+    static Long Init_Memory_Budget;
+    static bool first = true;
+
+    if (first)
+    {
+        first = false;
+        ParmParse pp("particles");
+        Init_Memory_Budget = Init_Memory_Budget_def;
+        pp.queryAdd("init_memory_budget", Init_Memory_Budget);
+        if (Init_Memory_Budget <= 0)
+        {
+            amrex::Abort("particles.init_memory_budget must be positive");
+        }
+    }
+
+    return Init_Memory_Budget;
+}
+
 const std::string& ParticleContainerBase::AggregationType ()
 {
     static std::string aggregation_type;
@@ -313,5 +356,36 @@ void ParticleContainerBase::BuildRedistributeMask (int lev, int nghost) const
             }
         }
         RemoveDuplicates(neighbor_procs);
+        neighbor_procs_comm.reset();
+    }
+}
+
+const Vector<int>& ParticleContainerBase::NeighborProcs (int ngrow) const
+{
+    const int nlevs = numLevels();
+    bool valid = (m_neighbor_procs_ngrow == ngrow) && (m_neighbor_procs_ba.size() == nlevs);
+    for (int lev = 0; valid && lev < nlevs; ++lev) {
+        valid = BoxArray::SameRefs(m_neighbor_procs_ba[lev], this->ParticleBoxArray(lev)) &&
+            DistributionMapping::SameRefs(m_neighbor_procs_dm[lev], this->ParticleDistributionMap(lev));
+    }
+
+    if (!valid) {
+        m_neighbor_procs = computeNeighborProcs(this->GetParGDB(), ngrow);
+        m_neighbor_procs_ngrow = ngrow;
+        m_neighbor_procs_ba.resize(nlevs);
+        m_neighbor_procs_dm.resize(nlevs);
+        for (int lev = 0; lev < nlevs; ++lev) {
+            m_neighbor_procs_ba[lev] = this->ParticleBoxArray(lev);
+            m_neighbor_procs_dm[lev] = this->ParticleDistributionMap(lev);
+        }
+        m_neighbor_procs_comm.reset();
     }
+
+    return m_neighbor_procs;
+}
+
+MPI_Comm ParticleContainerBase::NeighborProcsComm (int ngrow) const
+{
+    if (!useNeighborCollectives) { return MPI_COMM_NULL; }
+    return m_neighbor_procs_comm.get(NeighborProcs(ngrow));
 }
@@ -92,6 +92,107 @@ namespace amrex {
 
         return NumSnds;
     }
+
+    Long doHandShakeNeighbors(const std::map<int, Vector<char> >& not_ours,
+                              const Vector<int>& neighbor_procs, MPI_Comm neighbor_comm,
+                              Vector<Long>& Snds, Vector<Long>& Rcvs)
+    {
+        Long NumSnds = 0;
+        for (const auto& kv : not_ours)
+        {
+            NumSnds       += kv.second.size();
+            Snds[kv.first] = kv.second.size();
+        }
+
+        exchangeNeighborCounts(neighbor_procs, neighbor_comm, Snds, Rcvs);
+
+        return NumSnds;
+    }
+
+    void exchangeNeighborCounts(const Vector<int>& neighbor_procs, MPI_Comm neighbor_comm,
+                                const Vector<Long>& Snds, Vector<Long>& Rcvs)
+    {
+        BL_PROFILE("amrex::exchangeNeighborCounts");
+
+#if defined(MPI_VERSION) && (MPI_VERSION >= 3)
+        const int num_neighbors = neighbor_procs.size();
+        Vector<Long> snd_counts(num_neighbors);
+        Vector<Long> rcv_counts(num_neighbors);
+        for (int i = 0; i < num_neighbors; ++i) {
+            snd_counts[i] = Snds[neighbor_procs[i]];
+        }
+
+        BL_COMM_PROFILE(BLProfiler::Alltoall, sizeof(Long),
+                        ParallelContext::MyProcSub(), BLProfiler::BeforeCall());
+
+        BL_MPI_REQUIRE( MPI_Neighbor_alltoall(snd_counts.dataPtr(), 1,
+                                              ParallelDescriptor::Mpi_typemap<Long>::type(),
+                                              rcv_counts.dataPtr(), 1,
+                                              ParallelDescriptor::Mpi_typemap<Long>::type(),
+                                              neighbor_comm) );
+
+        BL_COMM_PROFILE(BLProfiler::Alltoall, sizeof(Long),
+                        ParallelContext::MyProcSub(), BLProfiler::AfterCall());
+
+        for (int i = 0; i < num_neighbors; ++i) {
+            Rcvs[neighbor_procs[i]] = rcv_counts[i];
+        }
+#else
+        amrex::ignore_unused(neighbor_procs, neighbor_comm, Snds, Rcvs);
+        amrex::Abort("exchangeNeighborCounts requires MPI 3");
+#endif
+    }
 #endif  // AMREX_USE_MPI
 
+ParticleNeighborComm::ParticleNeighborComm (ParticleNeighborComm&& rhs) noexcept
+    : m_comm(rhs.m_comm)
+{
+    rhs.m_comm = MPI_COMM_NULL;
+}
+
+ParticleNeighborComm&
+ParticleNeighborComm::operator= (ParticleNeighborComm&& rhs) noexcept
+{
+    if (this != &rhs) {
+        reset();
+        m_comm = rhs.m_comm;
+        rhs.m_comm = MPI_COMM_NULL;
+    }
+    return *this;
+}
+
+MPI_Comm
+ParticleNeighborComm::get (const Vector<int>& neighbor_procs)
+{
+#if defined(AMREX_USE_MPI) && defined(MPI_VERSION) && (MPI_VERSION >= 3)
+    if (ParallelContext::CommunicatorSub() != ParallelDescriptor::Communicator()) {
+        return MPI_COMM_NULL;
+    }
+    if (m_comm == MPI_COMM_NULL) {
+        const int n = neighbor_procs.size();
+        BL_MPI_REQUIRE( MPI_Dist_graph_create_adjacent(ParallelDescriptor::Communicator(),
+                                                       n, neighbor_procs.dataPtr(), MPI_UNWEIGHTED,
+                                                       n, neighbor_procs.dataPtr(), MPI_UNWEIGHTED,
+                                                       MPI_INFO_NULL, 0, &m_comm) );
+    }
+    return m_comm;
+#else
+    amrex::ignore_unused(neighbor_procs);
+    return MPI_COMM_NULL;
+#endif
+}
+
+void
+ParticleNeighborComm::reset ()
+{
+#ifdef AMREX_USE_MPI
+    if (m_comm != MPI_COMM_NULL) {
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        if (!finalized) { MPI_Comm_free(&m_comm); }
+        m_comm = MPI_COMM_NULL;
+    }
+#endif
+}
+
 }
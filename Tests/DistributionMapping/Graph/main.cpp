@@ -0,0 +1,176 @@
+#include <AMReX.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace amrex;
+
+namespace {
+
+    // The total cost of each rank
+    std::vector<Long> rankLoads (const DistributionMapping& dm,
+                                 const std::vector<Long>& wgts, int nprocs)
+    {
+        std::vector<Long> load(nprocs, 0);
+        for (int i = 0; i < dm.size(); ++i) {
+            AMREX_ALWAYS_ASSERT(dm[i] >= 0 && dm[i] < nprocs);
+            load[dm[i]] += wgts[i];
+        }
+        return load;
+    }
+
+    // Checks the GRAPH mapping of ba onto nprocs ranks, and that it cuts no
+    // more ghost cells than SFC if compare_sfc, i.e., if wgts are the volumes.
+    void checkGraph (const std::string& name, const BoxArray& ba,
+                     const std::vector<Long>& wgts, int nprocs, bool compare_sfc)
+    {
+        Real imbalance = 0.05_rt;
+        ParmParse pp("DistributionMapping");
+        pp.query("graph_imbalance", imbalance);
+
+        DistributionMapping graph;
+        Real graph_eff = 0.0;
+        graph.GraphProcessorMap(ba, wgts, nprocs, &graph_eff);
+
+        // The SFC mapping of the same boxes weighted by their volume
+        Vector<int> sfc_pmap(ba.size());
+        const auto sfc_boxes = DistributionMapping::makeSFC(ba, true, nprocs);
+        for (int rank = 0; rank < nprocs; ++rank) {
+            for (int i : sfc_boxes[rank]) { sfc_pmap[i] = rank; }
+        }
+        const DistributionMapping sfc(std::move(sfc_pmap));
+
+        // Every box is assigned to one of the ranks
+        AMREX_ALWAYS_ASSERT(graph.size() == ba.size());
+        const std::vector<Long> load = rankLoads(graph, wgts, nprocs);
+
+        Long graph_cut, graph_node_cut, sfc_cut, sfc_node_cut;
+        DistributionMapping::ComputeDistributionMappingEdgeCut(graph, ba, IntVect(1),
+                                                               &graph_cut, &graph_node_cut);
+        DistributionMapping::ComputeDistributionMappingEdgeCut(sfc, ba, IntVect(1),
+                                                               &sfc_cut, &sfc_node_cut);
+
+        amrex::Print() << name << ": " << ba.size() << " boxes on " << nprocs << " ranks,"
+                       << " GRAPH efficiency " << graph_eff << " edge cut " << graph_cut
+                       << " (" << graph_node_cut << " between nodes),"
+                       << " SFC edge cut " << sfc_cut
+                       << " (" << sfc_node_cut << " between nodes)\n";
+
+        const Long max_wgt = *std::max_element(wgts.begin(), wgts.end());
+        const Long max_load = *std::max_element(load.begin(), load.end());
+        if (nprocs >= ba.size()) {
+            // No rank gets more than one box, so the largest box sets the efficiency
+            AMREX_ALWAYS_ASSERT(max_load == max_wgt);
+        } else {
+            AMREX_ALWAYS_ASSERT(graph_eff >= 1.0_rt/(1.0_rt + imbalance));
+        }
+        if (compare_sfc) {
+            AMREX_ALWAYS_ASSERT(graph_cut <= sfc_cut);
+            AMREX_ALWAYS_ASSERT(graph_node_cut <= sfc_node_cut);
+        }
+    }
+
+    // The grids of a domain of n^DIM cells chopped into boxes of at most mgs cells
+    BoxArray makeGrids (int n, int mgs)
+    {
+        BoxArray ba(Box(IntVect(0), IntVect(n-1)));
+        ba.maxSize(mgs);
+        return ba;
+    }
+
+    // An L-shaped region with boxes of two sizes
+    BoxArray makeIrregularGrids (int n)
+    {
+        const Box domain(IntVect(0), IntVect(n-1));
+        const Box hole(IntVect(n/2), IntVect(n-1));
+        BoxList bl = amrex::boxDiff(domain, hole);
+        BoxArray ba(bl);
+        ba.maxSize(n/8);
+        BoxList fine;
+        for (int i = 0; i < ba.size(); ++i) {
+            if (ba[i].smallEnd(0) < n/4) {
+                BoxArray sub(ba[i]);
+                sub.maxSize(n/16);
+                for (int j = 0; j < sub.size(); ++j) { fine.push_back(sub[j]); }
+            } else {
+                fine.push_back(ba[i]);
+            }
+        }
+        return BoxArray(fine);
+    }
+
+    // The volume of each box, times hot if it is in the hot region
+    std::vector<Long> makeCosts (const BoxArray& ba, int n, int hot)
+    {
+        std::vector<Long> wgts(ba.size());
+        for (int i = 0; i < ba.size(); ++i) {
+            wgts[i] = ba[i].numPts() * (ba[i].smallEnd(0) < n/4 ? hot : 1);
+        }
+        return wgts;
+    }
+}
+
+void testGraph ()
+{
+    const int n = 128;
+    const BoxArray uniform = makeGrids(n, n/8);
+    const BoxArray irregular = makeIrregularGrids(n);
+
+#ifdef AMREX_USE_MPI
+    const std::vector<int> nprocs_list{2, 3, 8, 16};
+#else
+    // Without MPI, every rank of a mapping is rank 0
+    const std::vector<int> nprocs_list{1};
+#endif
+
+    for (int nprocs : nprocs_list) {
+        checkGraph("uniform", uniform, makeCosts(uniform, n, 1), nprocs, true);
+        checkGraph("irregular", irregular, makeCosts(irregular, n, 1), nprocs, true);
+        checkGraph("uniform, hot", uniform, makeCosts(uniform, n, 4), nprocs, false);
+        checkGraph("irregular, hot", irregular, makeCosts(irregular, n, 4), nprocs, false);
+    }
+
+#ifdef AMREX_USE_MPI
+    // More ranks than boxes
+    const BoxArray few = makeGrids(n, n/2);
+    checkGraph("few boxes", few, makeCosts(few, n, 4), 2*few.size()+1, false);
+#endif
+
+    // Zero costs, given directly and through makeGraph, balance the number of boxes
+    checkGraph("zero costs", uniform, std::vector<Long>(uniform.size(), 0),
+               nprocs_list.back(), false);
+    {
+        Real eff = 0.0;
+        const DistributionMapping dm = DistributionMapping::makeGraph(
+            Vector<Real>(uniform.size(), 0.0_rt), uniform, eff);
+        AMREX_ALWAYS_ASSERT(dm.size() == uniform.size());
+        AMREX_ALWAYS_ASSERT(eff > 0.0_rt && eff <= 1.0_rt);
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    testGraph();
+
+    // Again with the ranks grouped into nodes of 4
+    DistributionMapping::Finalize();
+    {
+        ParmParse pp("DistributionMapping");
+        pp.add("node_size", 4);
+    }
+    DistributionMapping::Initialize();
+    testGraph();
+
+    amrex::Print() << "pass \n";
+
+    amrex::Finalize();
+}
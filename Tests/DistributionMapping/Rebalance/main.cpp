@@ -0,0 +1,167 @@
+#include <AMReX.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+    // The number of bytes of the boxes whose owner differs between a and b
+    Long changedBytes (const DistributionMapping& a, const DistributionMapping& b,
+                       const Vector<Long>& bytes)
+    {
+        Long r = 0;
+        for (int i = 0; i < a.size(); ++i) {
+            if (a[i] != b[i]) { r += bytes[i]; }
+        }
+        return r;
+    }
+
+    // Rebalances dm for the costs rcost and checks the result.  Returns the
+    // number of bytes moved and the new mapping in pmap.
+    Long checkRebalance (const std::string& name, const DistributionMapping& dm,
+                         const Vector<Real>& rcost, const Vector<Long>& bytes,
+                         Real target, Vector<int>* pmap = nullptr)
+    {
+        Real current = 0.0, proposed = 0.0;
+        Long moved = -1;
+        const DistributionMapping rb = DistributionMapping::makeRebalance(
+            dm, rcost, bytes, target, current, proposed, moved);
+
+        // Zero costs are balanced as equal costs
+        const bool zero = *std::max_element(rcost.begin(), rcost.end()) == 0.0_rt;
+        Real actual = 0.0;
+        DistributionMapping::ComputeDistributionMappingEfficiency(
+            rb, zero ? Vector<Real>(rcost.size(), 1.0_rt) : rcost, &actual);
+
+        amrex::Print() << name << ": efficiency " << current << " -> " << proposed
+                       << " (" << actual << "), " << moved << " of "
+                       << std::accumulate(bytes.begin(), bytes.end(), Long(0))
+                       << " bytes moved\n";
+
+        AMREX_ALWAYS_ASSERT(rb.size() == dm.size());
+        for (int i = 0; i < rb.size(); ++i) {
+            AMREX_ALWAYS_ASSERT(rb[i] >= 0 && rb[i] < ParallelDescriptor::NProcs());
+        }
+        AMREX_ALWAYS_ASSERT(proposed >= current);
+        AMREX_ALWAYS_ASSERT(proposed >= target || current >= target);
+        AMREX_ALWAYS_ASSERT(std::abs(proposed - actual) < 1.e-6_rt);
+        AMREX_ALWAYS_ASSERT(moved == changedBytes(dm, rb, bytes));
+        if (current >= target) {
+            AMREX_ALWAYS_ASSERT(rb == dm && moved == 0);
+        }
+        if (pmap) { *pmap = rb.ProcessorMap(); }
+        return moved;
+    }
+}
+
+void testRebalance ()
+{
+    // 512 boxes of 16^DIM cells
+#if (AMREX_SPACEDIM == 1)
+    const IntVect nboxes(512);
+#elif (AMREX_SPACEDIM == 2)
+    const IntVect nboxes(32, 16);
+#else
+    const IntVect nboxes(8);
+#endif
+    const int mgs = 16;
+    BoxArray ba(Box(IntVect(0), nboxes*mgs - 1));
+    ba.maxSize(mgs);
+    const int N = ba.size();
+    AMREX_ALWAYS_ASSERT(N == 512);
+
+    Real target = 0.95_rt;
+    ParmParse pp("rebalance");
+    pp.query("target_efficiency", target);
+
+    Vector<Real> cost(N);
+    Vector<Long> bytes(N);
+    for (int i = 0; i < N; ++i) {
+        cost[i] = 1.0_rt + 0.1_rt*(i%7);
+        bytes[i] = ba[i].numPts() * sizeof(Real);
+    }
+    Real eff = 0.0;
+    const DistributionMapping dm = DistributionMapping::makeSFC(cost, ba, eff);
+
+    // Already balanced
+    checkRebalance("balanced", dm, cost, bytes, eff);
+
+    // The cost triples in a ball around a corner of the domain, which is
+    // mostly owned by one rank
+    const Box& domain = ba.minimalBox();
+    Vector<Real> drifted(cost);
+    for (int i = 0; i < N; ++i) {
+        Real r2 = 0.0;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            const Real x = Real(ba[i].smallEnd(idim) + ba[i].bigEnd(idim) + 1)
+                / Real(2*domain.length(idim));
+            r2 += x*x;
+        }
+        if (r2 < 0.5_rt*0.5_rt) { drifted[i] *= 3.0_rt; }
+    }
+    Vector<int> pmap;
+    const Long moved = checkRebalance("drifted", dm, drifted, bytes, target, &pmap);
+    const DistributionMapping rebalanced(std::move(pmap));
+
+    // Starting over moves more data
+    Real ks_eff = 0.0;
+    const DistributionMapping ks = DistributionMapping::makeKnapSack(drifted, ks_eff);
+    const Long ks_moved = changedBytes(dm, ks, bytes);
+    amrex::Print() << "knapsack: efficiency " << ks_eff << ", " << ks_moved << " bytes moved\n";
+    if (ParallelDescriptor::NProcs() > 1) {
+        AMREX_ALWAYS_ASSERT(moved > 0 && moved < ks_moved);
+    }
+
+    // The same through the MultiFab and LayoutData interfaces
+    {
+        MultiFab weight(ba, dm, 1, 0);
+        LayoutData<Real> ld(ba, dm);
+        for (MFIter mfi(weight); mfi.isValid(); ++mfi) {
+            const int i = mfi.index();
+            weight[mfi].setVal<RunOn::Host>(drifted[i]/ba[i].numPts());
+            ld[mfi] = drifted[i];
+        }
+        Real current = 0.0, proposed = 0.0;
+        Long ld_moved = -1;
+        const DistributionMapping rb = DistributionMapping::makeRebalance(
+            ld, sizeof(Real), target, current, proposed, ld_moved);
+        AMREX_ALWAYS_ASSERT(rb == rebalanced);
+        if (ParallelDescriptor::IOProcessor()) {
+            AMREX_ALWAYS_ASSERT(ld_moved == moved);
+        }
+
+        Long mf_moved = -1;
+        const DistributionMapping mf_rb = DistributionMapping::makeRebalance(
+            weight, sizeof(Real), target, current, proposed, mf_moved);
+        AMREX_ALWAYS_ASSERT(mf_moved == changedBytes(dm, mf_rb, bytes));
+        AMREX_ALWAYS_ASSERT(proposed >= target);
+    }
+
+    // Zero costs balance the number of boxes
+    checkRebalance("zero costs", dm, Vector<Real>(N, 0.0_rt), bytes, target);
+    {
+        Vector<int> pmap(N, 0);
+        const DistributionMapping one(std::move(pmap));
+        checkRebalance("zero costs, all on rank 0", one, Vector<Real>(N, 0.0_rt), bytes, target);
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    testRebalance();
+
+    amrex::Print() << "pass \n";
+
+    amrex::Finalize();
+}
@@ -0,0 +1,163 @@
+#include <AMReX.H>
+#include <AMReX_EB2.H>
+#include <AMReX_EB_STL_utils.H>
+#include <AMReX_EBFabFactory.H>
+#include <AMReX_FabConv.H>
+#include <AMReX_IntConv.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+    // Writes a binary STL file of a sphere triangulated with ntheta bands
+    // of nphi segments.  The normals point outward.
+    void write_sphere (std::string const& fname, Real radius, XDim3 const& center,
+                       int ntheta, int nphi)
+    {
+        const Real pi = Real(3.14159265358979323846);
+        auto vertex = [&] (int t, int p) -> std::array<float,3> {
+            Real theta = pi * t / ntheta;
+            Real phi = 2._rt * pi * p / nphi;
+            return {static_cast<float>(center.x + radius*std::sin(theta)*std::cos(phi)),
+                    static_cast<float>(center.y + radius*std::sin(theta)*std::sin(phi)),
+                    static_cast<float>(center.z + radius*std::cos(theta))};
+        };
+
+        Vector<std::array<float,3> > tris;
+        for (int t = 0; t < ntheta; ++t) {
+            for (int p = 0; p < nphi; ++p) {
+                auto a = vertex(t  , p  );
+                auto b = vertex(t+1, p  );
+                auto c = vertex(t+1, p+1);
+                auto d = vertex(t  , p+1);
+                if (t < ntheta-1) {
+                    tris.push_back(a);
+                    tris.push_back(b);
+                    tris.push_back(c);
+                }
+                if (t > 0) {
+                    tris.push_back(a);
+                    tris.push_back(c);
+                    tris.push_back(d);
+                }
+            }
+        }
+
+        IntDescriptor uint32_descr(sizeof(std::uint32_t), IntDescriptor::ReverseOrder);
+        IntDescriptor uint16_descr(sizeof(std::uint16_t), IntDescriptor::ReverseOrder);
+        RealDescriptor real32_descr(FPC::ieee_float, FPC::reverse_float_order, 4);
+
+        std::ofstream os(fname, std::ios::binary);
+        char header[80] = {};
+        os.write(header, 80);
+        std::uint32_t numtris = static_cast<std::uint32_t>(tris.size()/3);
+        amrex::writeIntData<std::uint32_t,std::uint32_t>(&numtris, 1, os, uint32_descr);
+        for (std::size_t i = 0; i < tris.size(); i += 3) {
+            float buf[12] = {0.f, 0.f, 0.f, // normal, recomputed by STLtools
+                             tris[i  ][0], tris[i  ][1], tris[i  ][2],
+                             tris[i+1][0], tris[i+1][1], tris[i+1][2],
+                             tris[i+2][0], tris[i+2][1], tris[i+2][2]};
+            RealDescriptor::convertFromNativeFloatFormat(os, 12, buf, real32_descr);
+            std::uint16_t attr = 0;
+            amrex::writeIntData<std::uint16_t,std::uint16_t>(&attr, 1, os, uint16_descr);
+        }
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 64;
+        int max_grid_size = 32;
+        int ntheta = 128;
+        std::string stl_file = "sphere.stl";
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("max_grid_size", max_grid_size);
+            pp.query("ntheta", ntheta);
+            pp.query("stl_file", stl_file);
+        }
+        const int nphi = 2*ntheta;
+        const Real radius = 0.3_rt;
+        const XDim3 center{0.5_rt, 0.5_rt, 0.5_rt};
+
+        if (ParallelDescriptor::IOProcessor()) {
+            write_sphere(stl_file, radius, center, ntheta, nphi);
+        }
+        ParallelDescriptor::Barrier();
+
+        Box domain(IntVect(0), IntVect(n_cell-1));
+        RealBox rb({0._rt,0._rt,0._rt}, {1._rt,1._rt,1._rt});
+        Geometry geom(domain, rb, 0, {0,0,0});
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        double t0 = amrex::second();
+        STLtools stl;
+        stl.read_stl_file(stl_file, 1._rt, {0._rt,0._rt,0._rt}, 0);
+        double t_read = amrex::second() - t0;
+
+        // Inside/outside test on the nodes
+        MultiFab mf(amrex::convert(ba,IntVect(1)), dm, 1, 0);
+        t0 = amrex::second();
+        stl.fill(mf, IntVect(0), geom);
+        double t_fill = amrex::second() - t0;
+
+        // Points well inside the inscribed sphere of the facets or outside
+        // the circumscribed sphere must be classified correctly.
+        const Real rin = radius * std::cos(Real(3.14159265358979323846)/ntheta);
+        const Real rout = radius * (1._rt + 1.e-4_rt);
+        const auto plo = geom.ProbLoArray();
+        const auto dx  = geom.CellSizeArray();
+        auto const& ma = mf.const_arrays();
+        int nwrong = ParReduce(TypeList<ReduceOpSum>{}, TypeList<int>{}, mf, IntVect(0),
+        [=] AMREX_GPU_DEVICE (int box_no, int i, int j, int k) -> GpuTuple<int>
+        {
+            Real x = plo[0]+i*dx[0] - center.x;
+            Real y = plo[1]+j*dx[1] - center.y;
+            Real z = plo[2]+k*dx[2] - center.z;
+            Real r = std::sqrt(x*x+y*y+z*z);
+            Real v = ma[box_no](i,j,k);
+            return { static_cast<int>((r < rin && v != 1._rt) || (r > rout && v != -1._rt)) };
+        });
+        ParallelDescriptor::ReduceIntSum(nwrong);
+
+        // Build the EB from the STL file
+        {
+            ParmParse pp("eb2");
+            pp.add("geom_type", std::string("stl"));
+            pp.add("stl_file", stl_file);
+        }
+        t0 = amrex::second();
+        EB2::Build(geom, 0, 0);
+        double t_eb = amrex::second() - t0;
+
+        auto factory = makeEBFabFactory(geom, ba, dm, {1,1,1}, EBSupport::volume);
+        Real covered = 1._rt - factory->getVolFrac().sum(0) * AMREX_D_TERM(dx[0],*dx[1],*dx[2]);
+        Real exact = 4._rt/3._rt * Real(3.14159265358979323846) * radius*radius*radius;
+
+        Print() << "STL sphere with " << 2*nphi*(ntheta-1)
+                << " triangles on a " << n_cell << "^3 grid\n"
+                << "  read + BVH build: " << t_read << " s\n"
+                << "  fill:             " << t_fill << " s\n"
+                << "  EB2::Build:       " << t_eb << " s\n"
+                << "  covered volume " << covered << ", exact " << exact << "\n"
+                << "  misclassified nodes: " << nwrong << "\n";
+
+        AMREX_ALWAYS_ASSERT(nwrong == 0);
+        AMREX_ALWAYS_ASSERT(std::abs(covered-exact) < 5.e-2_rt*exact);
+    }
+    amrex::Finalize();
+}
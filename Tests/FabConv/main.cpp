@@ -0,0 +1,146 @@
+#include <AMReX.H>
+#include <AMReX_FabConv.H>
+#include <AMReX_FPC.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Random.H>
+#include <AMReX_Utility.H>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+    // Returns the distance in units in the last place between a and b.
+    template <typename T>
+    Long ulp_diff (const T& a, const T& b)
+    {
+        if (a == b || (std::isnan(a) && std::isnan(b))) return 0;
+        if (std::signbit(a) != std::signbit(b)) return std::numeric_limits<Long>::max();
+        using U = typename std::conditional<sizeof(T)==4,std::int32_t,std::int64_t>::type;
+        U ia, ib;
+        std::memcpy(&ia, &a, sizeof(T));
+        std::memcpy(&ib, &b, sizeof(T));
+        return static_cast<Long>(ia > ib ? ia - ib : ib - ia);
+    }
+
+    // Converts nitems from native format to ord and returns the time per call.
+    double time_convert (Vector<char>& out, const Vector<char>& in, Long nitems,
+                         const RealDescriptor& ord, bool fast, int nrep)
+    {
+        RealDescriptor::SetFastConversion(fast);
+        out.resize(nitems*ord.numBytes());
+        double t0 = amrex::second();
+        for (int irep = 0; irep < nrep; ++irep) {
+            RealDescriptor::convertFromNativeFormat(out.data(), nitems,
+                                                   reinterpret_cast<const Real*>(in.data()), ord);
+        }
+        return (amrex::second() - t0) / nrep;
+    }
+
+    // Converts nitems from ird to native format and returns the time per call.
+    double time_convert_to_native (Vector<char>& out, const Vector<char>& in, Long nitems,
+                                   const RealDescriptor& ird, bool fast, int nrep)
+    {
+        RealDescriptor::SetFastConversion(fast);
+        out.resize(nitems*sizeof(Real));
+        double t0 = amrex::second();
+        for (int irep = 0; irep < nrep; ++irep) {
+            RealDescriptor::convertToNativeFormat(reinterpret_cast<Real*>(out.data()), nitems,
+                                                  const_cast<char*>(in.data()), ird);
+        }
+        return (amrex::second() - t0) / nrep;
+    }
+
+    template <typename T>
+    Long max_ulp_diff (const Vector<char>& a, const Vector<char>& b, const RealDescriptor& rd)
+    {
+        // Widening to native Real is exact, so compare in native format.
+        const Long nitems = a.size() / rd.numBytes();
+        Vector<Real> na(nitems), nb(nitems);
+        RealDescriptor::SetFastConversion(false);
+        RealDescriptor::convertToNativeFormat(na.data(), nitems, const_cast<char*>(a.data()), rd);
+        RealDescriptor::convertToNativeFormat(nb.data(), nitems, const_cast<char*>(b.data()), rd);
+        Long r = 0;
+        for (Long i = 0; i < nitems; ++i) {
+            r = std::max(r, ulp_diff(static_cast<T>(na[i]), static_cast<T>(nb[i])));
+        }
+        return r;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        Long nitems = 1 << 22;
+        int nrep = 5;
+        {
+            ParmParse pp;
+            pp.query("nitems", nitems);
+            pp.query("nrep", nrep);
+        }
+
+        // Native Reals with a wide range of magnitudes.
+        Vector<char> native(nitems*sizeof(Real));
+        {
+            Real* p = reinterpret_cast<Real*>(native.data());
+            for (Long i = 0; i < nitems; ++i) {
+                p[i] = static_cast<Real>((amrex::Random()-0.5) * std::pow(10.0, 20.0*amrex::Random()-10.0));
+            }
+        }
+
+        RealDescriptor ieee64_normal (FPC::ieee_double, FPC::normal_double_order,  8);
+        RealDescriptor ieee64_reverse(FPC::ieee_double, FPC::reverse_double_order, 8);
+        RealDescriptor ieee32_normal (FPC::ieee_float,  FPC::normal_float_order,   4);
+        RealDescriptor ieee32_reverse(FPC::ieee_float,  FPC::reverse_float_order,  4);
+
+        struct Case {
+            std::string name;
+            const RealDescriptor* rd;
+            bool narrowing;
+        };
+        const Vector<Case> cases {
+            {"IEEE64 big endian",    &ieee64_normal,  false},
+            {"IEEE64 little endian", &ieee64_reverse, false},
+            {"IEEE32 big endian",    &ieee32_normal,  sizeof(Real) == 8},
+            {"IEEE32 little endian", &ieee32_reverse, sizeof(Real) == 8}
+        };
+
+        Print() << "Converting " << nitems << " Reals, average of " << nrep << " calls\n";
+
+        for (const auto& c : cases)
+        {
+            const RealDescriptor& rd = *c.rd;
+            Vector<char> fast_out, generic_out, fast_back, generic_back;
+
+            // From native
+            double tf = time_convert(fast_out, native, nitems, rd, true, nrep);
+            double tg = time_convert(generic_out, native, nitems, rd, false, nrep);
+            // The generic path truncates when narrowing, the fast path rounds.
+            Long maxulp = (rd.numBytes() == 4) ? max_ulp_diff<float>(fast_out, generic_out, rd)
+                                               : max_ulp_diff<double>(fast_out, generic_out, rd);
+            Print() << "  native -> " << c.name << ": generic " << tg << " s, fast " << tf
+                    << " s, speedup " << tg/tf << ", max ulp difference " << maxulp << "\n";
+            AMREX_ALWAYS_ASSERT(maxulp <= (c.narrowing ? 1 : 0));
+
+            // Back to native
+            tf = time_convert_to_native(fast_back, fast_out, nitems, rd, true, nrep);
+            tg = time_convert_to_native(generic_back, fast_out, nitems, rd, false, nrep);
+            AMREX_ALWAYS_ASSERT(fast_back == generic_back);
+            Print() << "  " << c.name << " -> native: generic " << tg << " s, fast " << tf
+                    << " s, speedup " << tg/tf << "\n";
+            if (!c.narrowing) {
+                AMREX_ALWAYS_ASSERT(fast_back == native);
+            }
+        }
+
+        RealDescriptor::SetFastConversion(true);
+    }
+    amrex::Finalize();
+}
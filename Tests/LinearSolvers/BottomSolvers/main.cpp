@@ -0,0 +1,156 @@
+#include <AMReX.H>
+#include <AMReX_MLMG.H>
+#include <AMReX_MLPoisson.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+    struct SolveResult
+    {
+        int num_iters = 0;
+        int max_bottom_iters = 0;
+        int bottom_maxiter = 0;
+    };
+
+    // Solves a Poisson problem with Dirichlet boundaries using the given
+    // bottom solver.  The solution is returned in phi.
+    SolveResult solve (const Geometry& geom, const BoxArray& ba,
+                       const DistributionMapping& dm, const MultiFab& rhs,
+                       MultiFab& phi, MLMG::BottomSolver bottom_solver)
+    {
+        int verbose = 1;
+        int bottom_verbose = 0;
+        int max_coarsening_level = 2;
+        int bottom_sstep = 4;
+        int bottom_maxiter = 200;
+        ParmParse pp;
+        pp.query("verbose", verbose);
+        pp.query("bottom_verbose", bottom_verbose);
+        pp.query("max_coarsening_level", max_coarsening_level);
+        pp.query("bottom_sstep", bottom_sstep);
+        pp.query("bottom_maxiter", bottom_maxiter);
+
+        LPInfo info;
+        info.setMaxCoarseningLevel(max_coarsening_level);
+
+        MLPoisson mlpoisson({geom}, {ba}, {dm}, info);
+        mlpoisson.setDomainBC({AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                            LinOpBCType::Dirichlet,
+                                            LinOpBCType::Dirichlet)},
+                              {AMREX_D_DECL(LinOpBCType::Dirichlet,
+                                            LinOpBCType::Dirichlet,
+                                            LinOpBCType::Dirichlet)});
+        phi.setVal(0.0);
+        mlpoisson.setLevelBC(0, &phi);
+
+        MLMG mlmg(mlpoisson);
+        mlmg.setVerbose(verbose);
+        mlmg.setBottomVerbose(bottom_verbose);
+        mlmg.setBottomSolver(bottom_solver);
+        mlmg.setBottomSStep(bottom_sstep);
+        mlmg.setBottomMaxIter(bottom_maxiter);
+        mlmg.solve({&phi}, {&rhs}, 1.e-10_rt, 0.0_rt);
+
+        SolveResult r;
+        r.num_iters = mlmg.getNumIters();
+        r.bottom_maxiter = bottom_maxiter;
+        for (int n : mlmg.getNumCGIters()) {
+            r.max_bottom_iters = std::max(r.max_bottom_iters, n);
+        }
+        return r;
+    }
+}
+
+void testBottomSolvers ()
+{
+    int n_cell = 64;
+    int max_grid_size = 16;
+    ParmParse pp;
+    pp.query("n_cell", n_cell);
+    pp.query("max_grid_size", max_grid_size);
+
+    const Box domain(IntVect(0), IntVect(n_cell-1));
+    const RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    const Geometry geom(domain, rb, CoordSys::cartesian, {AMREX_D_DECL(0,0,0)});
+    BoxArray ba(domain);
+    ba.maxSize(max_grid_size);
+    const DistributionMapping dm(ba);
+
+    MultiFab rhs(ba, dm, 1, 0);
+    const auto problo = geom.ProbLoArray();
+    const auto dx = geom.CellSizeArray();
+    for (MFIter mfi(rhs); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.validbox();
+        const auto& f = rhs.array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            constexpr Real pi = 3.1415926535897932;
+            IntVect iv(AMREX_D_DECL(i,j,k));
+            Real r = 1.0;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const Real x = problo[idim] + (iv[idim]+0.5)*dx[idim];
+                r *= std::sin(3.0*pi*x) + 0.5*std::sin(8.0*pi*x);
+            }
+            f(i,j,k) = r;
+        });
+    }
+
+    struct Case
+    {
+        std::string name;
+        MLMG::BottomSolver bottom_solver;
+        int reference;
+    };
+    // The new solvers are compared with CG or BiCGStab
+    const Vector<Case> cases{{"bicgstab",          MLMG::BottomSolver::bicgstab,          -1},
+                             {"cg",                MLMG::BottomSolver::cg,                -1},
+                             {"pipelinedcg",       MLMG::BottomSolver::pipelinedcg,        1},
+                             {"pipelinedbicgstab", MLMG::BottomSolver::pipelinedbicgstab,  0},
+                             {"sstepcg",           MLMG::BottomSolver::sstepcg,            1}};
+
+    Vector<MultiFab> phi(cases.size());
+    Vector<SolveResult> result(cases.size());
+    for (int i = 0; i < cases.size(); ++i) {
+        phi[i].define(ba, dm, 1, 1);
+        result[i] = solve(geom, ba, dm, rhs, phi[i], cases[i].bottom_solver);
+
+        amrex::Print() << cases[i].name << ": " << result[i].num_iters
+                       << " MLMG iterations, at most " << result[i].max_bottom_iters
+                       << " bottom iterations\n";
+
+        // The bottom solver converged every time
+        AMREX_ALWAYS_ASSERT(result[i].max_bottom_iters > 0 &&
+                            result[i].max_bottom_iters < result[i].bottom_maxiter);
+
+        const int iref = cases[i].reference;
+        if (iref >= 0) {
+            // As fast as the reference, and to the same solution
+            AMREX_ALWAYS_ASSERT(result[i].num_iters <= result[iref].num_iters + 1);
+
+            MultiFab diff(ba, dm, 1, 0);
+            MultiFab::LinComb(diff, 1.0, phi[i], 0, -1.0, phi[iref], 0, 0, 1, 0);
+            const Real err = diff.norm0() / phi[iref].norm0();
+            amrex::Print() << "    difference from " << cases[iref].name << ": " << err << "\n";
+            AMREX_ALWAYS_ASSERT(err < 1.e-8_rt);
+        }
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    testBottomSolvers();
+
+    amrex::Print() << "pass \n";
+
+    amrex::Finalize();
+}
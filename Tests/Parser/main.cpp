@@ -1,6 +1,7 @@
 #include <AMReX.H>
 #include <AMReX_Parser.H>
 #include <AMReX_IParser.H>
+#include <AMReX_FArrayBox.H>
 #include <map>
 
 using namespace amrex;
@@ -8,6 +9,66 @@ using namespace amrex;
 static int max_stack_size = 0;
 static int test_number = 0;
 
+// Checks evalBatch against the results of the scalar executor.
+template <int N>
+int test_batch (ParserExecutor<N> const& exe, Vector<double> const* x,
+                Vector<double> const& r, Real reltol, Real abstol)
+{
+    const int n = static_cast<int>(r.size());
+    double const* xp[N];
+    for (int iv = 0; iv < N; ++iv) { xp[iv] = x[iv].data(); }
+    Vector<double> rb(n);
+    exe.evalBatch(n, xp, rb.data());
+    int nfail = 0;
+    for (int m = 0; m < n; ++m) {
+        double abserror = std::abs(rb[m]-r[m]);
+        double relerror = abserror / (1.e-50 + std::max(std::abs(rb[m]),std::abs(r[m])));
+        if (abserror > abstol && relerror > reltol) { ++nfail; }
+    }
+    if (nfail > 0) {
+        amrex::Print() << "\n    evalBatch failed " << nfail << " times";
+    }
+    return nfail;
+}
+
+// Times the scalar and batch executors on n points.
+template <int N, typename F>
+void benchmark (std::string const& f, std::map<std::string,Real> const& constants,
+                Vector<std::string> const& variables, F && fx, int n)
+{
+    Parser parser(f);
+    for (auto const& kv : constants) {
+        parser.setConstant(kv.first, kv.second);
+    }
+    parser.registerVariables(variables);
+    auto const exe = parser.compileHost<N>();
+
+    Array<Vector<double>,N> x;
+    double const* xp[N];
+    for (int iv = 0; iv < N; ++iv) {
+        x[iv].resize(n);
+        for (int m = 0; m < n; ++m) { x[iv][m] = fx(iv,m); }
+        xp[iv] = x[iv].data();
+    }
+    Vector<double> r(n);
+
+    double t0 = amrex::second();
+    for (int m = 0; m < n; ++m) {
+        GpuArray<double,N> v;
+        for (int iv = 0; iv < N; ++iv) { v[iv] = x[iv][m]; }
+        r[m] = exe(v);
+    }
+    double t_scalar = amrex::second() - t0;
+
+    t0 = amrex::second();
+    exe.evalBatch(n, xp, r.data());
+    double t_batch = amrex::second() - t0;
+
+    amrex::Print() << "  \"" << f << "\"\n"
+                   << "    stack size " << parser.maxStackSize()
+                   << ", scalar " << t_scalar << " s, batch " << t_batch << " s\n";
+}
+
 template <typename F>
 int test1 (std::string const& f,
            std::map<std::string,Real> const& constants,
@@ -27,11 +88,15 @@ int test1 (std::string const& f,
 
     GpuArray<Real,1> dx{(hi[0]-lo[0]) / (N-1)};
 
+    Array<Vector<double>,1> xb;
+    Vector<double> rb;
     int nfail = 0;
     Real max_relerror = 0.;
     for (int i = 0; i < N; ++i) {
         Real x = lo[0] + i*dx[0];
         Real result = exe(x);
+        xb[0].push_back(x);
+        rb.push_back(result);
         Real benchmark = fb(x);
         Real abserror = std::abs(result-benchmark);
         Real relerror = abserror / (1.e-50 + std::max(std::abs(result),std::abs(benchmark)));
@@ -42,6 +107,7 @@ int test1 (std::string const& f,
             ++nfail;
         }
     }
+    nfail += test_batch(exe, xb.data(), rb, reltol, abstol);
     if (nfail > 0) {
         amrex::Print() << "\n    failed " << nfail << " times.  Max rel. error: "
                        << max_relerror << "\n";
@@ -72,6 +138,8 @@ int test3 (std::string const& f,
     GpuArray<Real,3> dx{(hi[0]-lo[0]) / (N-1),
                         (hi[1]-lo[1]) / (N-1),
                         (hi[2]-lo[2]) / (N-1)};
+    Array<Vector<double>,3> xb;
+    Vector<double> rb;
     int nfail = 0;
     for (int i = 0; i < N; ++i) {
     for (int j = 0; j < N; ++j) {
@@ -80,6 +148,10 @@ int test3 (std::string const& f,
         Real y = lo[1] + j*dx[1];
         Real z = lo[2] + k*dx[2];
         Real result = exe(x,y,z);
+        xb[0].push_back(x);
+        xb[1].push_back(y);
+        xb[2].push_back(z);
+        rb.push_back(result);
         Real benchmark = fb(x,y,z);
         Real abserror = std::abs(result-benchmark);
         Real relerror = abserror / (1.e-50 + std::max(std::abs(result),std::abs(benchmark)));
@@ -89,6 +161,7 @@ int test3 (std::string const& f,
             ++nfail;
         }
     }}}
+    nfail += test_batch(exe, xb.data(), rb, reltol, abstol);
     if (nfail > 0) {
         amrex::Print() << "    failed " << nfail << " times\n";
         return 1;
@@ -119,6 +192,8 @@ int test4 (std::string const& f,
                         (hi[1]-lo[1]) / (N-1),
                         (hi[2]-lo[2]) / (N-1),
                         (hi[3]-lo[3]) / (N-1)};
+    Array<Vector<double>,4> xb;
+    Vector<double> rb;
     int nfail = 0;
     for (int i = 0; i < N; ++i) {
     for (int j = 0; j < N; ++j) {
@@ -129,6 +204,11 @@ int test4 (std::string const& f,
         Real z = lo[2] + k*dx[2];
         Real t = lo[3] + m*dx[3];
         Real result = exe(x,y,z,t);
+        xb[0].push_back(x);
+        xb[1].push_back(y);
+        xb[2].push_back(z);
+        xb[3].push_back(t);
+        rb.push_back(result);
         Real benchmark = fb(x,y,z,t);
         Real abserror = std::abs(result-benchmark);
         Real relerror = abserror / (1.e-50 + std::max(std::abs(result),std::abs(benchmark)));
@@ -138,6 +218,7 @@ int test4 (std::string const& f,
             ++nfail;
         }
     }}}}
+    nfail += test_batch(exe, xb.data(), rb, reltol, abstol);
     if (nfail > 0) {
         amrex::Print() << "    failed " << nfail << " times\n";
         return 1;
@@ -366,6 +447,54 @@ int main (int argc, char* argv[])
         amrex::Print() << "\n";
     }
 
+    {
+        // The repeated subexpressions of the first expression are
+        // eliminated at compile time, so it should run about as fast as the
+        // second one with explicit local variables.
+        amrex::Print() << "Parser benchmark\n";
+        auto fx = [] (int iv, int m) -> double {
+            return (iv < 3) ? -1. + 2.*std::fmod(0.618034*(m+1)*(iv+1), 1.0)
+                            : 10.*std::fmod(0.618034*(m+1), 1.0);
+        };
+        benchmark<4>("( (( (z-zc)*(z-zc) + (y-yc)*(y-yc) + (x-xc)*(x-xc) )^(0.5))>=r_star)*(-( (t<to)*(t/to)*omega + (t>=to)*omega )*(((x-xc)*(x-xc) + (y-yc)*(y-yc))^(0.5))/((1.0-( ( (t<to)*(t/to)*omega + (t>=to)*omega)  *(((x-xc)*(x-xc) + (y-yc)*(y-yc))^(0.5))/c)^2)^(0.5)) * (y-yc)/(((x-xc)*(x-xc) + (y-yc)*(y-yc))^(0.5)))",
+                     {{"xc", 0.1}, {"yc", -1.0}, {"zc", 0.2}, {"to", 3.}, {"omega", 0.33}, {"c", 30.}, {"r_star", 0.75}},
+                     {"x","y","z","t"}, fx, 1000000);
+        benchmark<4>("r=sqrt((z-zc)*(z-zc) + (y-yc)*(y-yc) + (x-xc)*(x-xc)); tomega=if(t>=to, omega, omega*(t/to)); r2d=sqrt((y-yc)*(y-yc) + (x-xc)*(x-xc)); (r>=r_star)*(-tomega*r/(1.0-((tomega*r2d/c)^2))^0.5 * (y-yc)/r)",
+                     {{"xc", 0.1}, {"yc", -1.0}, {"zc", 0.2}, {"to", 3.}, {"omega", 0.33}, {"c", 30.}, {"r_star", 0.75}},
+                     {"x","y","z","t"}, fx, 1000000);
+        benchmark<3>("epsilon/kp*2*x/w0**2*exp(-(x**2+y**2)/w0**2)*sin(k0*z)",
+                     {{"epsilon",0.01},{"kp",3.5},{"w0",5.e-6},{"k0",3.e5}},
+                     {"x","y","z"}, fx, 1000000);
+        amrex::Print() << "\n";
+    }
+
+    {
+        int nerror = 0;
+        amrex::Print() << test_number++ << ". Testing evalBatch on a Box   ";
+        Parser parser("sin(x)*cos(y)+x*y*z");
+        parser.registerVariables({"x","y","z"});
+        auto const exe = parser.compile<3>();
+        Box bx(IntVect(AMREX_D_DECL(-3,2,0)), IntVect(AMREX_D_DECL(37,9,4)));
+        FArrayBox fab(bx, 1, The_Pinned_Arena());
+        auto const& a = fab.array();
+        exe.evalBatch(bx, a, [=] AMREX_GPU_HOST_DEVICE (int i, int j, int k)
+                               -> GpuArray<double,3> { return {0.1*i, 0.2*j, 0.3*k}; });
+        Gpu::streamSynchronize();
+        amrex::LoopOnCpu(bx, [&] (int i, int j, int k)
+        {
+            Real x = 0.1*i, y = 0.2*j, z = 0.3*k;
+            if (std::abs(a(i,j,k) - (std::sin(x)*std::cos(y)+x*y*z)) > 1.e-12) { ++nerror; }
+        });
+        amrex::Print() << (nerror ? "    failed\n" : "    pass\n");
+        if (nerror > 0) {
+            amrex::Print() << nerror << " tests failed\n";
+            amrex::Abort();
+        } else {
+            amrex::Print() << "All tests passed\n";
+        }
+        amrex::Print() << "\n";
+    }
+
     {
         int count = 0;
         int x = 11;
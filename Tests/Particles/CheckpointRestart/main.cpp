@@ -0,0 +1,217 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Particles.H>
+
+using namespace amrex;
+
+static constexpr int NSR = 2;
+static constexpr int NSI = 1;
+static constexpr int NAR = 1;
+static constexpr int NAI = 1;
+
+using PC = ParticleContainer<NSR, NSI, NAR, NAI>;
+
+struct TestParams
+{
+    IntVect size;
+    int max_grid_size;
+    int restart_max_grid_size;
+    Long num_particles;
+};
+
+void get_test_params (TestParams& params)
+{
+    ParmParse pp("checkpoint");
+    pp.get("size", params.size);
+    pp.get("max_grid_size", params.max_grid_size);
+    pp.get("restart_max_grid_size", params.restart_max_grid_size);
+    pp.get("num_particles", params.num_particles);
+}
+
+AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+std::uint64_t mix (std::uint64_t h, std::uint64_t v) noexcept
+{
+    h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+}
+
+// An order independent checksum of every bit of every particle
+Long checksum (const PC& pc)
+{
+    using SPType = typename PC::SuperParticleType;
+    Long sum = amrex::ReduceSum(pc,
+        [=] AMREX_GPU_HOST_DEVICE (const SPType& p) -> Long
+        {
+            std::uint64_t h = mix(0, std::uint64_t(p.id()));
+            h = mix(h, std::uint64_t(p.cpu()));
+            for (int j = 0; j < AMREX_SPACEDIM + NSR + NAR; ++j) {
+                ParticleReal r = (j < AMREX_SPACEDIM) ? p.pos(j) : p.rdata(j-AMREX_SPACEDIM);
+                std::uint64_t bits = 0;
+                std::memcpy(&bits, &r, sizeof(r));
+                h = mix(h, bits);
+            }
+            for (int j = 0; j < NSI + NAI; ++j) {
+                h = mix(h, std::uint64_t(std::uint32_t(p.idata(j))));
+            }
+            return static_cast<Long>(h >> 33);
+        });
+    ParallelDescriptor::ReduceLongSum(sum);
+    return sum;
+}
+
+void testCheckpointRestart ()
+{
+    BL_PROFILE("testCheckpointRestart");
+    TestParams params;
+    get_test_params(params);
+
+    RealBox real_box;
+    for (int n = 0; n < AMREX_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, 1.0);
+    }
+
+    IntVect domain_lo(AMREX_D_DECL(0, 0, 0));
+    IntVect domain_hi(params.size - 1);
+    const Box domain(domain_lo, domain_hi);
+
+    int is_per[] = {AMREX_D_DECL(1,1,1)};
+    Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    PC pc(geom, dm, ba);
+    PC::ParticleInitData pdata = {{1.0, 2.0}, {3}, {4.0}, {5}};
+    pc.InitRandom(params.num_particles, 451, pdata);
+
+    // Give every particle different attributes.
+    const int nlevs = pc.numLevels();
+    for (int lev = 0; lev < nlevs; ++lev)
+    {
+        for (PC::ParIterType pti(pc, lev); pti.isValid(); ++pti)
+        {
+            auto ptd = pti.GetParticleTile().getParticleTileData();
+            amrex::ParallelFor(pti.numParticles(),
+            [=] AMREX_GPU_DEVICE (int i) noexcept
+            {
+                auto& p = ptd.m_aos[i];
+                p.rdata(0) = p.pos(0) * p.id();
+                p.rdata(1) = p.pos(1) + p.pos(2);
+                p.idata(0) = p.id() % 17;
+                ptd.m_rdata[0][i] = p.pos(0) - p.pos(1);
+                ptd.m_idata[0][i] = -p.id();
+            });
+        }
+    }
+
+    const Long np = pc.TotalNumberOfParticles();
+    const Long sum = checksum(pc);
+
+    BoxArray restart_ba(domain);
+    restart_ba.maxSize(params.restart_max_grid_size);
+    DistributionMapping restart_dm(restart_ba);
+
+    // The legacy format, then the chunked format without and with compression
+    const std::pair<bool,bool> formats[] = {{false, false}, {true, false}, {true, true}};
+    for (const auto& format : formats)
+    {
+        PC::chunkedCheckpoint = format.first;
+        PC::compressCheckpoint = format.second;
+
+        const std::string dir = std::string("chk_") + (format.first ? "chunked" : "legacy")
+                              + (format.second ? "_compressed" : "");
+        amrex::UtilCreateCleanDirectory(dir, true);
+        pc.Checkpoint(dir, "particles");
+
+        PC restart_pc(geom, restart_dm, restart_ba);
+        restart_pc.Restart(dir, "particles");
+
+        amrex::Print() << dir << ": restarted with " << restart_pc.TotalNumberOfParticles()
+                       << " of " << np << " particles\n";
+
+        AMREX_ALWAYS_ASSERT(restart_pc.TotalNumberOfParticles() == np);
+        AMREX_ALWAYS_ASSERT(checksum(restart_pc) == sum);
+        AMREX_ALWAYS_ASSERT(restart_pc.OK());
+    }
+
+}
+
+// Particles outside a non-periodic domain are dropped on restart, and
+// never abort the chunked reader.
+void testOutsideDomain ()
+{
+    BL_PROFILE("testOutsideDomain");
+    TestParams params;
+    get_test_params(params);
+
+    RealBox real_box;
+    for (int n = 0; n < AMREX_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, 1.0);
+    }
+
+    const Box domain(IntVect(AMREX_D_DECL(0, 0, 0)), params.size - 1);
+    int is_per[] = {AMREX_D_DECL(0,0,0)};
+    Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    PC pc(geom, dm, ba);
+    PC::ParticleInitData pdata = {{1.0, 2.0}, {3}, {4.0}, {5}};
+    pc.InitRandom(params.num_particles, 451, pdata);
+
+    // Move every tenth particle out of the domain without redistributing.
+    Long nout = 0;
+    for (PC::ParIterType pti(pc, 0); pti.isValid(); ++pti)
+    {
+        auto& aos = pti.GetArrayOfStructs();
+        for (auto& p : aos) {
+            if (p.id() % 10 == 0) {
+                p.pos(0) += 1.5;
+                ++nout;
+            }
+        }
+    }
+    ParallelDescriptor::ReduceLongSum(nout);
+    const Long np = pc.TotalNumberOfParticles();
+
+    const std::pair<bool,bool> formats[] = {{false, false}, {true, false}, {true, true}};
+    for (const auto& format : formats)
+    {
+        PC::chunkedCheckpoint = format.first;
+        PC::compressCheckpoint = format.second;
+
+        const std::string dir = std::string("chk_outside_") + (format.first ? "chunked" : "legacy")
+                              + (format.second ? "_compressed" : "");
+        amrex::UtilCreateCleanDirectory(dir, true);
+        pc.Checkpoint(dir, "particles");
+
+        PC restart_pc(geom, dm, ba);
+        restart_pc.Restart(dir, "particles");
+
+        amrex::Print() << dir << ": restarted with " << restart_pc.TotalNumberOfParticles()
+                       << " of " << np << " particles, " << nout << " outside\n";
+
+        AMREX_ALWAYS_ASSERT(nout > 0);
+        AMREX_ALWAYS_ASSERT(restart_pc.TotalNumberOfParticles() == np - nout);
+        AMREX_ALWAYS_ASSERT(restart_pc.OK());
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    testCheckpointRestart();
+    testOutsideDomain();
+
+    amrex::Print() << "pass \n";
+
+    amrex::Finalize();
+}
@@ -0,0 +1,148 @@
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Particles.H>
+
+#include <fstream>
+
+using namespace amrex;
+
+using PC = ParticleContainer<3, 0>;
+
+struct TestParams
+{
+    IntVect size;
+    int max_grid_size;
+    Long num_particles;
+};
+
+void get_test_params (TestParams& params)
+{
+    ParmParse pp("binary");
+    pp.get("size", params.size);
+    pp.get("max_grid_size", params.max_grid_size);
+    pp.get("num_particles", params.num_particles);
+}
+
+// The data of particle i: the positions, some of them outside the periodic
+// domain, followed by three extra components.
+double particle_data (Long i, int j)
+{
+    std::uint64_t h = (std::uint64_t(i) * 0x9e3779b97f4a7c15ULL) ^ std::uint64_t(j+1);
+    h ^= h >> 29; h *= 0xbf58476d1ce4e5b9ULL; h ^= h >> 32;
+    double r = double(h % 1000003) / 1000003.;
+    if (j == 0 && i % 100 == 0) { r += 1.0; }
+    return (j < AMREX_SPACEDIM) ? r : r * (j+1);
+}
+
+template <typename T>
+void write_binary_file (const std::string& file, Long np)
+{
+    if (!ParallelDescriptor::IOProcessor()) return;
+
+    std::ofstream ofs(file, std::ios::out | std::ios::binary);
+    const int dm = AMREX_SPACEDIM;
+    const int nx = 3;
+    ofs.write((const char*)&np, sizeof(np));
+    ofs.write((const char*)&dm, sizeof(dm));
+    ofs.write((const char*)&nx, sizeof(nx));
+    for (Long i = 0; i < np; ++i) {
+        for (int j = 0; j < dm + nx; ++j) {
+            T r = static_cast<T>(particle_data(i, j));
+            ofs.write((const char*)&r, sizeof(r));
+        }
+    }
+}
+
+template <typename T>
+void testInitFromBinary (const Geometry& geom, const DistributionMapping& dm,
+                         const BoxArray& ba, Long np)
+{
+    BL_PROFILE("testInitFromBinary");
+
+    const std::string file = sizeof(T) == sizeof(float) ? "particles_float.bin"
+                                                        : "particles_double.bin";
+    write_binary_file<T>(file, np);
+    ParallelDescriptor::Barrier();
+
+    PC pc(geom, dm, ba);
+    pc.InitFromBinaryFile(file, 2);
+
+    // The sums of every component that was read, with the periodic shift applied.
+    constexpr int ncomp = AMREX_SPACEDIM + 2;
+    Array<double,ncomp> expected;
+    for (int j = 0; j < ncomp; ++j) {
+        expected[j] = 0.0;
+        for (Long i = 0; i < np; ++i) {
+            double r = static_cast<T>(particle_data(i, j));
+            if (j < AMREX_SPACEDIM && r >= 1.0) { r -= 1.0; }
+            expected[j] += r;
+        }
+    }
+
+    using SPType = typename PC::SuperParticleType;
+    ReduceOps<AMREX_D_DECL(ReduceOpSum, ReduceOpSum, ReduceOpSum), ReduceOpSum, ReduceOpSum> reduce_ops;
+    auto r = ParticleReduce<ReduceData<AMREX_D_DECL(double, double, double), double, double> >(
+        pc, [=] AMREX_GPU_DEVICE (const SPType& p) noexcept
+            -> GpuTuple<AMREX_D_DECL(double, double, double), double, double>
+        {
+            return {AMREX_D_DECL(p.pos(0), p.pos(1), p.pos(2)), p.rdata(0), p.rdata(1)};
+        }, reduce_ops);
+    Array<double,ncomp> sum = {AMREX_D_DECL(amrex::get<0>(r), amrex::get<1>(r), amrex::get<2>(r)),
+                               amrex::get<AMREX_SPACEDIM>(r), amrex::get<AMREX_SPACEDIM+1>(r)};
+    ParallelDescriptor::ReduceRealSum(sum.data(), ncomp);
+
+    // With one rank the ids must be consecutive
+    Long min_id = amrex::ReduceMin(pc, [=] AMREX_GPU_HOST_DEVICE (const SPType& p) -> Long
+                                       { return p.id(); });
+    Long max_id = amrex::ReduceMax(pc, [=] AMREX_GPU_HOST_DEVICE (const SPType& p) -> Long
+                                       { return p.id(); });
+    Long id_sum = amrex::ReduceSum(pc, [=] AMREX_GPU_HOST_DEVICE (const SPType& p) -> Long
+                                       { return p.id(); });
+    ParallelDescriptor::ReduceLongMax(max_id);
+    ParallelDescriptor::ReduceLongSum(id_sum);
+
+    amrex::Print() << file << ": read " << pc.TotalNumberOfParticles() << " of " << np
+                   << " particles\n";
+
+    AMREX_ALWAYS_ASSERT(pc.TotalNumberOfParticles() == np);
+    AMREX_ALWAYS_ASSERT(pc.OK());
+    for (int j = 0; j < ncomp; ++j) {
+        AMREX_ALWAYS_ASSERT(std::abs(sum[j] - expected[j]) <= 1.e-9 * std::abs(expected[j]));
+    }
+    if (ParallelDescriptor::NProcs() == 1) {
+        AMREX_ALWAYS_ASSERT(max_id - min_id + 1 == np && 2*id_sum == np*(min_id+max_id));
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        TestParams params;
+        get_test_params(params);
+
+        RealBox real_box;
+        for (int n = 0; n < AMREX_SPACEDIM; n++)
+        {
+            real_box.setLo(n, 0.0);
+            real_box.setHi(n, 1.0);
+        }
+
+        IntVect domain_lo(AMREX_D_DECL(0, 0, 0));
+        IntVect domain_hi(params.size - 1);
+        const Box domain(domain_lo, domain_hi);
+
+        int is_per[] = {AMREX_D_DECL(1,1,1)};
+        Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+
+        BoxArray ba(domain);
+        ba.maxSize(params.max_grid_size);
+        DistributionMapping dm(ba);
+
+        testInitFromBinary<float>(geom, dm, ba, params.num_particles);
+        testInitFromBinary<double>(geom, dm, ba, params.num_particles);
+
+        amrex::Print() << "pass \n";
+    }
+    amrex::Finalize();
+}
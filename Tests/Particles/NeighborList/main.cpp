@@ -15,6 +15,7 @@ struct TestParams
 };
 
 void testNeighborList();
+void testVerletSkin();
 
 int main (int argc, char* argv[])
 {
@@ -22,6 +23,8 @@ int main (int argc, char* argv[])
 
     testNeighborList();
 
+    testVerletSkin();
+
     amrex::Finalize();
 }
 
@@ -139,3 +142,187 @@ void testNeighborList ()
         nlist2.print();
     }
 }
+
+struct VerletParams
+{
+    int num_ppc;
+    int nsteps;
+    amrex::Real cutoff;
+    amrex::Real skin;
+    amrex::Real max_step;
+};
+
+struct CheckVerletPair
+{
+    amrex::Real m_cutoff2;
+
+    template <class P1, class P2>
+    AMREX_GPU_DEVICE AMREX_FORCE_INLINE
+    bool operator() (const P1& p1, const P2& p2) const
+    {
+        AMREX_D_TERM(amrex::Real d0 = (p1.pos(0) - p2.pos(0));,
+                     amrex::Real d1 = (p1.pos(1) - p2.pos(1));,
+                     amrex::Real d2 = (p1.pos(2) - p2.pos(2));)
+        amrex::Real dsquared = AMREX_D_TERM(d0*d0, + d1*d1, + d2*d2);
+        return (dsquared <= m_cutoff2);
+    }
+};
+
+// The velocity is stored in the real components.
+class MDContainer
+    : public amrex::NeighborParticleContainer<AMREX_SPACEDIM, 0>
+{
+public:
+    MDContainer (const Geometry& geom, const DistributionMapping& dm, const BoxArray& ba)
+        : NeighborParticleContainer<AMREX_SPACEDIM, 0>(geom, dm, ba, 1)
+    {}
+
+    void init (int num_ppc, amrex::Real max_step)
+    {
+        const Long np = Long(num_ppc) * this->Geom(0).Domain().numPts();
+        ParticleInitData pdata = {{}, {}, {}, {}};
+        InitRandom(np, 1234, pdata);
+
+        for (MyParIter pti(*this, 0); pti.isValid(); ++pti)
+        {
+            auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+            amrex::ParallelFor(pti.numParticles(), [=] AMREX_GPU_DEVICE (int i) noexcept
+            {
+                auto& p = pstruct[i];
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    std::uint64_t h = (std::uint64_t(p.id()) * 0x9e3779b97f4a7c15ULL) ^ (idim+1);
+                    h ^= h >> 29; h *= 0xbf58476d1ce4e5b9ULL; h ^= h >> 32;
+                    p.rdata(idim) = max_step * (amrex::Real(h % 2001) / 1000 - 1);
+                }
+            });
+        }
+    }
+
+    void move ()
+    {
+        for (MyParIter pti(*this, 0); pti.isValid(); ++pti)
+        {
+            auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+            amrex::ParallelFor(pti.numParticles(), [=] AMREX_GPU_DEVICE (int i) noexcept
+            {
+                auto& p = pstruct[i];
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    p.pos(idim) += p.rdata(idim);
+                }
+            });
+        }
+    }
+
+    // The number of pairs closer than cutoff, counted once from each side
+    Long countPairs (amrex::Real cutoff)
+    {
+        BL_PROFILE("MDContainer::countPairs");
+        const amrex::Real cutoff2 = cutoff*cutoff;
+        ReduceOps<ReduceOpSum> reduce_op;
+        ReduceData<Long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        for (MyParIter pti(*this, 0); pti.isValid(); ++pti)
+        {
+            PairIndex index(pti.index(), pti.LocalTileIndex());
+            const auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+            auto nbor_data = m_neighbor_list[0][index].data();
+            reduce_op.eval(pti.numParticles(), reduce_data,
+            [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+            {
+                const auto& p1 = pstruct[i];
+                Long n = 0;
+                for (const auto& p2 : nbor_data.getNeighbors(i)) {
+                    AMREX_D_TERM(amrex::Real d0 = (p1.pos(0) - p2.pos(0));,
+                                 amrex::Real d1 = (p1.pos(1) - p2.pos(1));,
+                                 amrex::Real d2 = (p1.pos(2) - p2.pos(2));)
+                    if (AMREX_D_TERM(d0*d0, + d1*d1, + d2*d2) < cutoff2) { ++n; }
+                }
+                return {n};
+            });
+        }
+        Long n = amrex::get<0>(reduce_data.value(reduce_op));
+        ParallelAllReduce::Sum(n, ParallelContext::CommunicatorSub());
+        return n;
+    }
+};
+
+// Run the same trajectory rebuilding the neighbor list every step and with a
+// Verlet skin, and check that they find the same pairs.
+void testVerletSkin ()
+{
+    BL_PROFILE("testVerletSkin");
+    TestParams params;
+    get_test_params(params, "nbor_list");
+
+    VerletParams vparams;
+    ParmParse pp("verlet");
+    pp.get("num_ppc", vparams.num_ppc);
+    pp.get("nsteps", vparams.nsteps);
+    pp.get("cutoff", vparams.cutoff);
+    pp.get("skin", vparams.skin);
+    pp.get("max_step", vparams.max_step);
+
+    RealBox real_box;
+    for (int n = 0; n < AMREX_SPACEDIM; n++)
+    {
+        real_box.setLo(n, 0.0);
+        real_box.setHi(n, params.size[n]);
+    }
+
+    const Box domain(IntVect(AMREX_D_DECL(0, 0, 0)), params.size - 1);
+    int is_per[] = {AMREX_D_DECL(1,1,1)};
+    Geometry geom(domain, &real_box, CoordSys::cartesian, is_per);
+    AMREX_ALWAYS_ASSERT(vparams.cutoff + vparams.skin <= geom.CellSize(0));
+
+    BoxArray ba(domain);
+    ba.maxSize(params.max_grid_size);
+    DistributionMapping dm(ba);
+
+    MDContainer rebuild_pc(geom, dm, ba);
+    MDContainer verlet_pc(geom, dm, ba);
+    rebuild_pc.init(vparams.num_ppc, vparams.max_step);
+    verlet_pc.copyParticles(rebuild_pc, true);
+    verlet_pc.setVerletSkin(vparams.skin);
+
+    const CheckVerletPair rebuild_check{vparams.cutoff*vparams.cutoff};
+    const CheckVerletPair verlet_check{(vparams.cutoff+vparams.skin)*(vparams.cutoff+vparams.skin)};
+
+    double rebuild_time = 0.0;
+    double verlet_time = 0.0;
+    int nbuilds = 0;
+    for (int step = 0; step < vparams.nsteps; ++step)
+    {
+        double t0 = amrex::second();
+        {
+            BL_PROFILE("testVerletSkin::rebuild");
+            rebuild_pc.updateNeighborList(rebuild_check);
+        }
+        const Long rebuild_pairs = rebuild_pc.countPairs(vparams.cutoff);
+        double t1 = amrex::second();
+        {
+            BL_PROFILE("testVerletSkin::verlet");
+            // The list must be kept as long as no particle moved more than half the skin
+            const bool expect_build = 2*verlet_pc.maxDisplacementSinceBuild() > vparams.skin;
+            const bool built = verlet_pc.updateNeighborList(verlet_check);
+            AMREX_ALWAYS_ASSERT(built == expect_build);
+            if (built) { ++nbuilds; }
+        }
+        const Long verlet_pairs = verlet_pc.countPairs(vparams.cutoff);
+        double t2 = amrex::second();
+        rebuild_time += t1 - t0;
+        verlet_time += t2 - t1;
+
+        AMREX_ALWAYS_ASSERT(rebuild_pairs == verlet_pairs);
+
+        rebuild_pc.move();
+        verlet_pc.move();
+    }
+
+    AMREX_ALWAYS_ASSERT(nbuilds < vparams.nsteps);
+
+    ParallelDescriptor::ReduceRealMax(rebuild_time);
+    ParallelDescriptor::ReduceRealMax(verlet_time);
+    amrex::Print() << "Verlet skin: " << nbuilds << " list builds in " << vparams.nsteps
+                   << " steps, " << verlet_time << " s, vs. " << rebuild_time
+                   << " s rebuilding every step\n";
+}
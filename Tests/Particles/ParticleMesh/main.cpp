@@ -16,6 +16,7 @@ struct TestParams {
   int nz;
   int max_grid_size;
   int nppc;
+  int nbench;
   bool verbose;
 };
 
@@ -90,6 +91,51 @@ void testParticleMesh (TestParams& parms)
                       });
       });
 
+  // Compare depositing through per-tile temporary fabs with depositing
+  // directly into the fabs with a colored tile schedule.
+  if (parms.nbench > 0) {
+      const int ncomp = 1 + 2*AMREX_SPACEDIM;
+      auto deposit = [=] AMREX_GPU_DEVICE (const MyParticleContainer::ParticleType& p,
+                                           amrex::Array4<amrex::Real> const& rho)
+      {
+          ParticleInterpolator::Linear interp(p, plo, dxi);
+
+          interp.ParticleToMesh(p, rho, 0, 0, ncomp,
+                      [=] AMREX_GPU_DEVICE (const MyParticleContainer::ParticleType& part, int comp)
+                      {
+                          return part.rdata(comp);
+                      });
+      };
+
+      MultiFab rho_local(ba, dmap, ncomp, 1);
+      MultiFab rho_colored(ba, dmap, ncomp, 1);
+
+      const bool colored_deposition = ParticleContainerBase::coloredDeposition;
+      for (int colored = 0; colored < 2; ++colored)
+      {
+          ParticleContainerBase::coloredDeposition = colored;
+          MultiFab& rho = colored ? rho_colored : rho_local;
+
+          amrex::ParticleToMesh(myPC, rho, 0, deposit);
+
+          double t0 = amrex::second();
+          for (int n = 0; n < parms.nbench; ++n) {
+              amrex::ParticleToMesh(myPC, rho, 0, deposit);
+          }
+          double dt = (amrex::second() - t0) / parms.nbench;
+          ParallelDescriptor::ReduceRealMax(dt);
+
+          amrex::Print() << "ParticleToMesh with " << ncomp << " components, "
+                         << (colored ? "colored tiles     : " : "temporary fabs    : ")
+                         << dt << " seconds\n";
+      }
+      ParticleContainerBase::coloredDeposition = colored_deposition;
+
+      const Real rho_max = rho_local.norm0();
+      MultiFab::Subtract(rho_colored, rho_local, 0, 0, ncomp, 0);
+      AMREX_ALWAYS_ASSERT(rho_colored.norm0() <= 1.e-12 * rho_max);
+  }
+
   MultiFab acceleration(ba, dmap, AMREX_SPACEDIM, 1);
   acceleration.setVal(5.0);
 
@@ -170,6 +216,9 @@ int main(int argc, char* argv[])
   if (parms.nppc < 1 && ParallelDescriptor::IOProcessor())
     amrex::Abort("Must specify at least one particle per cell");
 
+  parms.nbench = 0;
+  pp.query("nbench", parms.nbench);
+
   parms.verbose = false;
   pp.query("verbose", parms.verbose);
 
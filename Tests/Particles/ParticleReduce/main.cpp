@@ -242,5 +242,44 @@ void testReduce ()
         AMREX_ALWAYS_ASSERT(amrex::get<2>(r) == 1);
     }
 
+    {
+        // One pass and one MPI reduction for several diagnostics at once
+        auto f = [=] AMREX_GPU_DEVICE (const SPType& p) noexcept
+            -> amrex::GpuTuple<amrex::Real, amrex::Real, amrex::Real, int, Long>
+        {
+            return {p.rdata(1), p.pos(0), p.pos(0), p.idata(0) == 0, 1};
+        };
+        amrex::ReduceOps<ReduceOpSum, ReduceOpMax, ReduceOpMin, ReduceOpLogicalAnd, ReduceOpSum> reduce_ops;
+        using RD = ReduceData<amrex::Real, amrex::Real, amrex::Real, int, Long>;
+        auto r = amrex::ParticleAllReduce<RD>(pc, f, reduce_ops);
+
+        auto sum = amrex::ReduceSum(pc, [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real { return p.rdata(1); });
+        auto xmax = amrex::ReduceMax(pc, [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real { return p.pos(0); });
+        auto xmin = amrex::ReduceMin(pc, [=] AMREX_GPU_HOST_DEVICE (const PType& p) -> Real { return p.pos(0); });
+        ParallelDescriptor::ReduceRealSum(sum);
+        ParallelDescriptor::ReduceRealMax(xmax);
+        ParallelDescriptor::ReduceRealMin(xmin);
+
+        AMREX_ALWAYS_ASSERT(amrex::get<0>(r) == sum);
+        AMREX_ALWAYS_ASSERT(amrex::get<1>(r) == xmax);
+        AMREX_ALWAYS_ASSERT(amrex::get<2>(r) == xmin);
+        AMREX_ALWAYS_ASSERT(amrex::get<3>(r) == 1);
+        AMREX_ALWAYS_ASSERT(amrex::get<4>(r) == pc.TotalNumberOfParticles());
+
+        // The non-blocking version, with the particles changing before the result is used
+        auto future = amrex::ParticleIAllReduce<RD>(pc, 0, pc.finestLevel(), f, reduce_ops);
+        for (TestParticleContainer::ParIterType pti(pc, 0); pti.isValid(); ++pti)
+        {
+            auto* pstruct = pti.GetArrayOfStructs()().dataPtr();
+            amrex::ParallelFor(pti.numParticles(), [=] AMREX_GPU_DEVICE (int i) noexcept
+            {
+                pstruct[i].rdata(1) = 2;
+            });
+        }
+        auto r2 = future.get();
+        AMREX_ALWAYS_ASSERT(amrex::get<0>(r2) == sum);
+        AMREX_ALWAYS_ASSERT(amrex::get<4>(r2) == amrex::get<4>(r));
+    }
+
     amrex::Print() << "pass \n";
 }
@@ -309,6 +309,38 @@ public:
             }
         }
     }
+
+    void checkSorted ()
+    {
+        BL_PROFILE("TestParticleContainer::checkSorted");
+
+        for (int lev = 0; lev <= finestLevel(); ++lev)
+        {
+            const auto dxi = Geom(lev).InvCellSizeArray();
+            const auto plo = Geom(lev).ProbLoArray();
+            const auto domain = Geom(lev).Domain();
+            for(MFIter mfi = MakeMFIter(lev); mfi.isValid(); ++mfi)
+            {
+                auto& ptile = ParticlesAt(lev, mfi);
+                const Box& box = mfi.tilebox();
+                const auto& offsets = ptile.GetCellOffsets();
+                AMREX_ALWAYS_ASSERT(ptile.GetCellSortBox() == box);
+                AMREX_ALWAYS_ASSERT(offsets.size() == static_cast<std::size_t>(box.numPts()+1));
+
+                const auto ptd = ptile.getConstParticleTileData();
+                const auto poffsets = offsets.dataPtr();
+                const auto np = ptile.numParticles();
+                GetParticleBin get_bin{plo, dxi, domain, IntVect(AMREX_D_DECL(1, 1, 1)), box};
+
+                AMREX_FOR_1D ( np, i,
+                {
+                    const auto b = get_bin(ptd.m_aos[i]);
+                    const auto ui = static_cast<unsigned int>(i);
+                    AMREX_ALWAYS_ASSERT(poffsets[b] <= ui && ui < poffsets[b+1]);
+                });
+            }
+        }
+    }
 };
 
 struct TestParams
@@ -430,8 +462,9 @@ void testRedistribute ()
             pc.negateEven();
         }
         pc.RedistributeLocal();
-        if (params.sort) pc.SortParticlesByCell();
+        if (params.sort && !pc.maintainCellSort) pc.SortParticlesByCell();
         pc.checkAnswer();
+        if (params.sort) pc.checkSorted();
     }
 
     if (params.do_regrid)
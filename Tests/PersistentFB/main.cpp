@@ -0,0 +1,102 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+using namespace amrex;
+
+namespace {
+
+    // Sets the valid cells to values that depend on the iteration and the
+    // ghost cells to a value that FillBoundary must overwrite.
+    void set_data (MultiFab& mf, int iter)
+    {
+        mf.setVal(-1.e10);
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            const Box& bx = mfi.validbox();
+            const auto& a = mf.array(mfi);
+            const int ncomp = mf.nComp();
+            amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+            {
+                a(i,j,k,n) = Real(i) + Real(100)*j + Real(10000)*k + Real(0.5)*n + Real(0.25)*iter;
+            });
+        }
+    }
+
+    // Returns the max difference between a and b, ghost cells included.
+    Real max_diff (const MultiFab& a, const MultiFab& b)
+    {
+        MultiFab d(a.boxArray(), a.DistributionMap(), a.nComp(), a.nGrowVect());
+        MultiFab::LinComb(d, 1.0, a, 0, -1.0, b, 0, 0, a.nComp(), a.nGrowVect());
+        return d.norm0(0, a.nComp(), a.nGrowVect());
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 8;
+        int ngrow = 2;
+        int niters = 5;
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size", max_grid_size);
+        pp.query("ngrow", ngrow);
+        pp.query("niters", niters);
+
+        const bool use_persistent_fb = FabArrayBase::use_persistent_fb;
+        amrex::Print() << "fabarray.use_persistent_fb = " << use_persistent_fb << "\n";
+
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        const Periodicity period(domain.size());
+        BoxArray ba(domain);
+        ba.maxSize(max_grid_size);
+        const DistributionMapping dm(ba);
+
+        // Keeps the FB in the cache for all the MultiFabs below.
+        MultiFab keep(ba, dm, 1, ngrow);
+
+        Real err = 0.0;
+        for (int ncomp : {1, 3}) {
+            MultiFab a(ba, dm, ncomp, ngrow);
+            MultiFab a2(ba, dm, ncomp, ngrow);
+            MultiFab b(ba, dm, ncomp, ngrow);
+            for (int iter = 0; iter < niters; ++iter) {
+                set_data(b, iter);
+                FabArrayBase::use_persistent_fb = false;
+                b.FillBoundary(period);
+                FabArrayBase::use_persistent_fb = use_persistent_fb;
+
+                set_data(a, iter);
+                a.FillBoundary(period);
+                err = std::max(err, max_diff(a, b));
+
+                // Two FabArrays with the same FB in flight at the same time.
+                // The second one cannot use the persistent requests.
+                set_data(a, iter);
+                set_data(a2, iter);
+                a.FillBoundary_nowait(period);
+                a2.FillBoundary_nowait(period);
+                a2.FillBoundary_finish();
+                a.FillBoundary_finish();
+                err = std::max(err, max_diff(a, b));
+                err = std::max(err, max_diff(a2, b));
+            }
+        }
+        amrex::Print() << "Max difference from non-persistent FillBoundary: " << err << "\n";
+        AMREX_ALWAYS_ASSERT(err == 0.0);
+
+#ifdef AMREX_USE_MPI
+        // Both numbers of components have their own persistent requests.
+        if (use_persistent_fb && ParallelDescriptor::NProcs() > 1) {
+            const auto& fb = keep.getFB(IntVect(ngrow), period);
+            amrex::Print() << "Persistent requests: " << fb.m_persistent_comm.size() << "\n";
+            AMREX_ALWAYS_ASSERT(fb.m_persistent_comm.size() == 2);
+        }
+#endif
+    }
+    amrex::Print() << "pass \n";
+    amrex::Finalize();
+}
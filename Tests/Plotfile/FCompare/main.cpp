@@ -0,0 +1,53 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_PlotFileUtil.H>
+#include <AMReX_Print.H>
+
+#include <cmath>
+
+using namespace amrex;
+
+// Writes three plotfiles for the fcompare tests: plt_a, plt_near, which
+// differs from plt_a by roundoff, also where plt_a is zero, and plt_far,
+// which also differs by 1.e-3 in one zone.
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        const int n_cell = 32;
+        const Box domain(IntVect(0), IntVect(n_cell-1));
+        const RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+        const Geometry geom(domain, rb, CoordSys::cartesian, {AMREX_D_DECL(0,0,0)});
+        BoxArray ba(domain);
+        ba.maxSize(16);
+        const DistributionMapping dm(ba);
+
+        MultiFab a(ba, dm, 2, 0), near(ba, dm, 2, 0), far(ba, dm, 2, 0);
+        const IntVect far_cell(n_cell/3);
+        for (MFIter mfi(a); mfi.isValid(); ++mfi) {
+            const Box& bx = mfi.validbox();
+            const auto& fa = a.array(mfi);
+            const auto& fn = near.array(mfi);
+            const auto& ff = far.array(mfi);
+            amrex::LoopOnCpu(bx, 2, [=] (int i, int j, int k, int n) noexcept
+            {
+                // Zero in the lower half of the domain
+                const Real x = (i+0.5)/n_cell;
+                const Real y = (j+0.5)/n_cell;
+                Real v = (j < n_cell/2) ? 0.0 : std::sin(6.0*x + n) + std::cos(4.0*y);
+                fa(i,j,k,n) = v;
+                fn(i,j,k,n) = v*(1.0 + 1.e-14) + 1.e-13*((i+j+k+n)%3 - 1);
+                ff(i,j,k,n) = fn(i,j,k,n);
+                if (IntVect(AMREX_D_DECL(i,j,k)) == far_cell) {
+                    ff(i,j,k,n) += 1.e-3;
+                }
+            });
+        }
+
+        const Vector<std::string> varnames{"u", "v"};
+        WriteSingleLevelPlotfile("plt_a", a, varnames, geom, 0.0, 0);
+        WriteSingleLevelPlotfile("plt_near", near, varnames, geom, 0.0, 0);
+        WriteSingleLevelPlotfile("plt_far", far, varnames, geom, 0.0, 0);
+    }
+    amrex::Finalize();
+}
@@ -0,0 +1,211 @@
+#include <AMReX.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace amrex;
+
+namespace {
+
+    volatile double sink = 0.0;
+
+    void work (int n)
+    {
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) {
+            s += std::sqrt(double(i));
+        }
+        sink = sink + s;
+    }
+
+    void leaf ()
+    {
+        BL_PROFILE_ID("tp_leaf");
+        work(1000);
+    }
+
+    void mid ()
+    {
+        BL_PROFILE_ID("tp_mid");
+        leaf();
+        work(1000);
+        leaf();
+    }
+
+    struct Event
+    {
+        std::string name;
+        double ts = 0.0;
+        double dur = 0.0;
+        int tid = 0;
+    };
+
+    double get_number (std::string const& line, std::string const& key)
+    {
+        auto pos = line.find("\"" + key + "\": ");
+        if (pos == std::string::npos) { return -1.0; }
+        return std::stod(line.substr(pos + key.size() + 4));
+    }
+
+    // Reads the events of a trace file written by the tiny profiler, one
+    // event per line.
+    std::vector<Event> read_trace (std::string const& file)
+    {
+        std::vector<Event> events;
+        std::ifstream ifs(file);
+        std::string line;
+        while (std::getline(ifs, line)) {
+            auto pos = line.find("{\"name\": \"");
+            if (pos == std::string::npos) { continue; }
+            pos += 10;
+            Event e;
+            e.name = line.substr(pos, line.find('"', pos) - pos);
+            e.ts = get_number(line, "ts");
+            e.dur = get_number(line, "dur");
+            e.tid = static_cast<int>(get_number(line, "tid"));
+            events.push_back(e);
+        }
+        return events;
+    }
+
+    // Returns the number of calls of a timer in the first table of a
+    // section of the output, or -1 if the timer is not there.
+    long get_ncalls (std::string const& section, std::string const& name)
+    {
+        std::istringstream is(section);
+        std::string line;
+        while (std::getline(is, line)) {
+            std::istringstream ls(line);
+            std::string fname;
+            long ncalls = -1;
+            if (ls >> fname >> ncalls && fname == name) {
+                return ncalls;
+            }
+        }
+        return -1;
+    }
+
+    std::string get_region (std::string const& out, std::string const& region)
+    {
+        auto begin = out.find("BEGIN REGION " + region + "\n");
+        auto end = out.find("END REGION " + region + "\n");
+        if (begin == std::string::npos || end == std::string::npos) { return std::string(); }
+        return out.substr(begin, end-begin);
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    std::ostringstream os;
+    amrex::Initialize(argc, argv, true, MPI_COMM_WORLD,
+                      [] () {
+                          ParmParse pp("tiny_profiler");
+                          pp.add("trace_file", std::string("tp_trace"));
+                      },
+                      os);
+
+    const int myproc = ParallelDescriptor::MyProc();
+    const int nleaf_omp = 100;
+
+    for (int i = 0; i < 10; ++i) {
+        BL_PROFILE("tp_outer");
+        mid();
+    }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < nleaf_omp; ++i) {
+        BL_PROFILE_ID("tp_omp");
+        work(1000);
+    }
+
+    // Timers stopped out of order
+    {
+        const int a = TinyProfiler::InternName("tp_bad_a");
+        const int b = TinyProfiler::InternName("tp_bad_b");
+        const int c = TinyProfiler::InternName("tp_bad_c");
+        TinyProfiler::StartID(a);
+        TinyProfiler::StartID(b);
+        TinyProfiler::StopID(a);
+        TinyProfiler::StopID(c);
+    }
+
+    amrex::Finalize();
+
+    int nerrors = 0;
+    auto check = [&] (bool ok, std::string const& msg)
+    {
+        if (!ok) {
+            std::cout << "FAIL: " << msg << std::endl;
+            ++nerrors;
+        }
+    };
+
+    const std::string out = os.str();
+    if (myproc == 0) {
+        // The timers by ID are reported in their own region
+        const std::string main_region = out.substr(0, out.find("BEGIN REGION"));
+        const std::string id_region = get_region(out, "BL_PROFILE_ID");
+        check(!id_region.empty(), "region BL_PROFILE_ID");
+        check(get_ncalls(main_region, "tp_outer") == 10, "tp_outer calls");
+        check(get_ncalls(main_region, "tp_mid") == -1, "tp_mid not in main region");
+        check(get_ncalls(id_region, "tp_mid") == 10, "tp_mid calls");
+        check(get_ncalls(id_region, "tp_leaf") == 20, "tp_leaf calls");
+        check(get_ncalls(id_region, "tp_omp") == nleaf_omp, "tp_omp calls");
+        check(get_ncalls(id_region, "tp_bad_a") == 1, "tp_bad_a calls");
+        check(get_ncalls(id_region, "tp_bad_b") == -1, "tp_bad_b dropped");
+
+        auto warning = out.find("not properly nested");
+        check(warning != std::string::npos, "nesting warning");
+        if (warning != std::string::npos) {
+            const std::string names = out.substr(warning, out.find("\n\n", warning) - warning);
+            for (auto const* name : {"tp_bad_a", "tp_bad_b", "tp_bad_c"}) {
+                check(names.find(name) != std::string::npos, std::string("nesting warning for ") + name);
+            }
+            check(names.find("tp_mid") == std::string::npos, "no nesting warning for tp_mid");
+        }
+    }
+
+    // Every timer stopped is in the trace, and the events of nested timers
+    // are inside those of their parents.
+    const auto events = read_trace("tp_trace." + std::to_string(myproc) + ".json");
+    std::map<std::string,int> nevents;
+    for (auto const& e : events) {
+        ++nevents[e.name];
+    }
+    check(nevents["tp_outer"] == 10, "tp_outer events");
+    check(nevents["tp_mid"] == 10, "tp_mid events");
+    check(nevents["tp_leaf"] == 20, "tp_leaf events");
+    check(nevents["tp_omp"] == nleaf_omp, "tp_omp events");
+    check(nevents["tp_bad_a"] == 1, "tp_bad_a events");
+    check(nevents["tp_bad_b"] == 0, "tp_bad_b events");
+
+    constexpr double eps = 1.e-3; // microseconds
+    for (auto const& leaf_event : events) {
+        if (leaf_event.name != "tp_leaf") { continue; }
+        int nparents = 0;
+        for (auto const& e : events) {
+            if (e.name == "tp_mid" && e.tid == leaf_event.tid &&
+                e.ts <= leaf_event.ts + eps &&
+                leaf_event.ts + leaf_event.dur <= e.ts + e.dur + eps) {
+                ++nparents;
+            }
+        }
+        check(nparents == 1, "tp_leaf event inside tp_mid event");
+    }
+
+    if (nerrors == 0) {
+        std::cout << "pass" << std::endl;
+    }
+    return nerrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_VisMF.H>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+using namespace amrex;
+
+namespace {
+
+    // Returns a deterministic value that depends on all the arguments.  Some
+    // components are smooth and compress well, the others are noise that
+    // does not compress, so that both compressed and raw chunks are written.
+    Real value (int i, int j, int k, int n, int fab)
+    {
+        if (n % 2 == 0) {
+            return std::sin(0.1*i) * std::cos(0.2*j) + 0.01*k + n + 10*fab;
+        } else {
+            std::uint64_t h = (std::uint64_t(i+100) * 73856093U) ^ (std::uint64_t(j+100) * 19349663U)
+                ^ (std::uint64_t(k+100) * 83492791U) ^ (std::uint64_t(n) * 2654435761U)
+                ^ (std::uint64_t(fab) * 40503U);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            return static_cast<Real>(h % 1000003) / Real(7.0);
+        }
+    }
+
+    // Returns the number of points of fab that are not bitwise identical to
+    // the same points of the FAB of mf on its whole box, ghost cells
+    // included.  If icomp >= 0, fab holds only that component.
+    Long count_diffs (const FArrayBox& fab, const MultiFab& mf, const MFIter& mfi, int icomp)
+    {
+        const Box& bx = mfi.fabbox();
+        if (fab.box() != bx) { return bx.numPts(); }
+
+        const int ncomp = icomp < 0 ? mf.nComp() : 1;
+        const int scomp = icomp < 0 ? 0 : icomp;
+        FArrayBox hfab(bx, ncomp, The_Pinned_Arena());
+        hfab.copy<RunOn::Device>(fab, 0, 0, ncomp);
+        Gpu::streamSynchronize();
+
+        const auto& a = hfab.const_array();
+        const auto& b = mf.const_array(mfi);
+        Long ndiffs = 0;
+        amrex::LoopOnCpu(bx, ncomp, [&] (int i, int j, int k, int n)
+        {
+            if (std::memcmp(&a(i,j,k,n), &b(i,j,k,n+scomp), sizeof(Real)) != 0) {
+                ++ndiffs;
+            }
+        });
+        return ndiffs;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+    {
+        int n_cell = 32;
+        int max_grid_size = 16;
+        int ncomp = 4;
+        int ngrow = 2;
+        Long chunk_size = 4096;
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size", max_grid_size);
+        pp.query("ncomp", ncomp);
+        pp.query("ngrow", ngrow);
+        pp.query("chunk_size", chunk_size);
+
+        BoxArray ba(Box(IntVect(0), IntVect(n_cell-1)));
+        ba.maxSize(max_grid_size);
+        DistributionMapping dm(ba);
+
+        MultiFab mf(ba, dm, ncomp, ngrow, MFInfo().SetArena(The_Pinned_Arena()));
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            const auto& a = mf.array(mfi);
+            const int fab = mfi.index();
+            amrex::LoopOnCpu(mfi.fabbox(), ncomp, [&] (int i, int j, int k, int n)
+            {
+                a(i,j,k,n) = value(i, j, k, n, fab);
+            });
+        }
+
+        // Each component of each FAB is split into many chunks.
+        const Long fab_bytes = (max_grid_size+2*ngrow)*(max_grid_size+2*ngrow)
+            *(max_grid_size+2*ngrow)*Long(sizeof(Real));
+        AMREX_ALWAYS_ASSERT(fab_bytes > 4*chunk_size);
+
+        const auto old_version = VisMF::GetHeaderVersion();
+        const auto old_chunk_size = VisMF::GetCompressionChunkSize();
+        const bool old_threaded = VisMF::GetUseThreadedReads();
+
+        VisMF::SetHeaderVersion(VisMF::Header::NoFabHeaderCompressed_v1);
+        VisMF::SetCompressionChunkSize(chunk_size);
+        const std::string name("vismf_compressed");
+        VisMF::Write(mf, name);
+
+        Long ndiffs = 0;
+
+        // The whole MultiFab, with the regular and the threaded readers.
+        for (int threaded = 0; threaded < 2; ++threaded) {
+            VisMF::SetUseThreadedReads(threaded);
+            MultiFab mf2(ba, dm, ncomp, ngrow);
+            VisMF::Read(mf2, name);
+            AMREX_ALWAYS_ASSERT(mf2.nGrow() == ngrow);
+            Long nd = 0;
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                nd += count_diffs(mf2[mfi], mf, mfi, -1);
+            }
+            amrex::Print() << "VisMF::Read, threaded reads = " << threaded << ": "
+                           << nd << " differences on rank 0\n";
+            ndiffs += nd;
+        }
+
+        // One FAB at a time, all components or one of them.
+        {
+            VisMF vismf(name);
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                std::unique_ptr<FArrayBox> fab(vismf.readFAB(mfi.index(), name));
+                ndiffs += count_diffs(*fab, mf, mfi, -1);
+                for (int n = 0; n < ncomp; ++n) {
+                    std::unique_ptr<FArrayBox> fabn(vismf.readFAB(mfi.index(), n));
+                    ndiffs += count_diffs(*fabn, mf, mfi, n);
+                }
+            }
+        }
+
+        VisMF::SetHeaderVersion(old_version);
+        VisMF::SetCompressionChunkSize(old_chunk_size);
+        VisMF::SetUseThreadedReads(old_threaded);
+
+        ParallelDescriptor::ReduceLongSum(ndiffs);
+        amrex::Print() << "Total differences: " << ndiffs << "\n";
+        AMREX_ALWAYS_ASSERT(ndiffs == 0);
+    }
+    amrex::Print() << "pass \n";
+    amrex::Finalize();
+}
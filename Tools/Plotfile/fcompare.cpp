@@ -1,10 +1,12 @@
 #include <AMReX.H>
 #include <AMReX_Print.H>
 #include <AMReX_PlotFileUtil.H>
+#include <AMReX_BoxIterator.H>
 #include <algorithm>
 #include <limits>
 #include <cmath>
 #include <cstdlib>
+#include <utility>
 
 using namespace amrex;
 
@@ -24,7 +26,7 @@ void PrintUsage()
         << " variable.\n"
         << "\n"
         << " usage:\n"
-        << "    fcompare [-n|--norm num] [-d|--diffvar var] [-z|--zone_info var] [-a|--allow_diff_grids] [-r|rel_tol] [--abs_tol] file1 file2\n"
+        << "    fcompare [-n|--norm num] [-d|--diffvar var] [-z|--zone_info var] [-a|--allow_diff_grids] [-r|rel_tol] [--abs_tol] [-s|--stream] [--abort_on_first_diff] file1 file2\n"
         << "\n"
         << " optional arguments:\n"
         << "    -n|--norm num         : what norm to use (default is 0 for inf norm)\n"
@@ -35,6 +37,15 @@ void PrintUsage()
         << "    -a|--allow_diff_grids : allow different BoxArrays covering the same domain\n"
         << "    -r|--rel_tol rtol     : relative tolerance (default is 0)\n"
         << "    --abs_tol atol        : absolute tolerance (default is 0)\n"
+        << "    -s|--stream           : compare one grid at a time as it is read from\n"
+        << "                            disk instead of reading whole levels; levels\n"
+        << "                            whose grids differ are still read whole\n"
+        << "    --abort_on_first_diff : stop at the first zone whose |A - B| alone\n"
+        << "                            makes the level fail both the absolute and the\n"
+        << "                            relative test (implies --stream); ||A|| is\n"
+        << "                            bounded with the min and max in the header of A.\n"
+        << "                            With -a, levels whose grids differ are checked\n"
+        << "                            one variable at a time after they are read whole\n"
         << std::endl;
 }
 
@@ -60,6 +71,8 @@ int main_main()
     std::string zone_info_var_name;
     Vector<std::string> plot_names(1);
     bool abort_if_not_all_found = false;
+    bool stream = false;
+    bool abort_on_first_diff = false;
 
     int farg = 1;
     while (farg <= narg) {
@@ -87,6 +100,11 @@ int main_main()
             atol = std::stod(amrex::get_command_argument(++farg));
         } else if (fname == "--abort_if_not_all_found") {
             abort_if_not_all_found = true;
+        } else if (fname == "-s" || fname == "--stream") {
+            stream = true;
+        } else if (fname == "--abort_on_first_diff") {
+            stream = true;
+            abort_on_first_diff = true;
         } else {
             break;
         }
@@ -189,6 +207,52 @@ int main_main()
                    << "  " << std::setw(24) << "(||A - B||/||A||)" << "\n"
                    << " " << std::string(76,'-') << "\n";
 
+    // Every process has stopped or finished comparing a level; report the
+    // difference found by the lowest numbered process, if any.
+    auto report_first_diff = [&] (bool found_diff, int ilev, int diff_comp, int diff_gid,
+                                  const IntVect& diff_cell, Real diff_a, Real diff_b) -> bool
+    {
+        const int myproc = ParallelDescriptor::MyProc();
+        int diff_proc = found_diff ? myproc : ParallelDescriptor::NProcs();
+        ParallelDescriptor::ReduceIntMin(diff_proc);
+        if (diff_proc == ParallelDescriptor::NProcs()) {
+            return false;
+        }
+        ParallelDescriptor::Barrier();
+        if (myproc == diff_proc) {
+            amrex::AllPrint() << std::endl
+                              << " first difference in " << names_a[diff_comp] << "\n"
+                              << "   level = " << ilev << " grid = " << diff_gid
+                              << " (i,j,k) = " << diff_cell << "\n"
+                              << "   A = " << std::setprecision(17) << diff_a
+                              << "  B = " << diff_b << "\n";
+        }
+        return true;
+    };
+
+    // A zone where |B - A| = d exceeds both thresholds fails the level:
+    // ||B - A|| >= d*dv^(1/norm) > atol and ||B - A||/||A|| >= d/a_norm > rtol,
+    // where a_norm >= ||A||.  Without a bound on ||A||, only rtol = 0 is
+    // known to fail.
+    auto abort_thresholds = [&] (int ilev, Real a_norm) -> std::pair<Real,Real>
+    {
+        Real abs_thresh = atol;
+        if (norm != 0) {
+            const auto& dx = pf_a.cellSize(ilev);
+            Real dv = 1.0;
+            for (int idim = 0; idim < dm; ++idim) {
+                dv *= dx[idim];
+            }
+            abs_thresh /= std::pow(dv,1./static_cast<Real>(norm));
+        }
+        Real rel_thresh = 0.0;
+        if (rtol > 0.0) {
+            rel_thresh = (a_norm < std::numeric_limits<Real>::max())
+                ? rtol*a_norm : std::numeric_limits<Real>::max();
+        }
+        return {abs_thresh, rel_thresh};
+    };
+
     // go level-by-level and patch-by-patch and compare the data
     for (int ilev = 0; ilev < nlevels; ++ilev)
     {
@@ -211,65 +275,276 @@ int main_main()
         Vector<Real> rerror_denom(ncomp_a, 0.0);
         Vector<int> has_nan_a(ncomp_a, false);
         Vector<int> has_nan_b(ncomp_a, false);
-        for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
-            if (ivar_b[icomp_a] >= 0) {
-                const MultiFab& mf_a = pf_a.get(ilev, names_a[icomp_a]);
-                MultiFab mf_b;
-                if (grids_match) {
-                    mf_b = pf_b.get(ilev, names_b[ivar_b[icomp_a]]);
-                } else {
-                    mf_b.define(mf_a.boxArray(), mf_a.DistributionMap(), 1, 0);
-                    MultiFab tmp = pf_b.get(ilev, names_b[ivar_b[icomp_a]]);
-                    mf_b.ParallelCopy(tmp);
-                }
-                has_nan_a[icomp_a] = mf_a.contains_nan();
-                has_nan_b[icomp_a] = mf_b.contains_nan();
-                MultiFab::Subtract(mf_b,mf_a,0,0,1,0); // b = b - a
-                Real max_err = mf_b.norm0();
-                if (norm == 1) {
-                    aerror[icomp_a] = mf_b.norm1();
-                    rerror[icomp_a] = aerror[icomp_a];
-                    rerror_denom[icomp_a] = mf_a.norm1();
-                } else if (norm == 2) {
-                    aerror[icomp_a] = mf_b.norm2();
-                    rerror[icomp_a] = aerror[icomp_a];
-                    rerror_denom[icomp_a] = mf_a.norm2();
-                } else {
-                    aerror[icomp_a] = max_err;
-                    rerror[icomp_a] = aerror[icomp_a];
-                    rerror_denom[icomp_a] = mf_a.norm0();
+        if (stream && grids_match) {
+            // Read one grid of A and of B at a time, in the order A is stored
+            // on disk, and accumulate the norms of A and of B - A.  With norm
+            // 1 or 2, the sums of |x| or x^2 are kept in aerror and
+            // rerror_denom until all the grids have been seen.
+            const BoxArray& ba = pf_a.boxArray(ilev);
+            const DistributionMapping& dmap = pf_a.DistributionMap(ilev);
+            const int myproc = ParallelDescriptor::MyProc();
+
+            Real zone_max_err = std::numeric_limits<Real>::lowest();
+            int zone_gid = -1;
+            IntVect zone_cell;
+
+            bool found_diff = false;
+            int diff_gid = -1;
+            int diff_comp = -1;
+            IntVect diff_cell;
+            Real diff_a = 0.0, diff_b = 0.0;
+
+            // Bound ||A|| with the largest |A| of each grid in the header
+            Vector<std::pair<Real,Real> > thresholds(ncomp_a);
+            if (abort_on_first_diff) {
+                for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
+                    if (ivar_b[icomp_a] < 0) { continue; }
+                    const Vector<Real> fab_max = pf_a.maxAbs(ilev, names_a[icomp_a]);
+                    Real a_norm = std::numeric_limits<Real>::max();
+                    if (!fab_max.empty()) {
+                        a_norm = 0.0;
+                        for (int gid = 0; gid < fab_max.size(); ++gid) {
+                            if (norm == 0) {
+                                a_norm = std::max(a_norm, fab_max[gid]);
+                            } else {
+                                a_norm += static_cast<Real>(ba[gid].numPts())
+                                    * std::pow(fab_max[gid], static_cast<Real>(norm));
+                            }
+                        }
+                        if (norm != 0) {
+                            a_norm = std::pow(a_norm, 1./static_cast<Real>(norm));
+                        }
+                    }
+                    thresholds[icomp_a] = abort_thresholds(ilev, a_norm);
                 }
+            }
+
+            for (int gid : pf_a.fileOrder(ilev)) {
+                if (dmap[gid] != myproc) { continue; }
+
+                const FArrayBox fab_a = pf_a.getFab(ilev, gid);
+                const FArrayBox fab_b = pf_b.getFab(ilev, gid);
+                const Box& bx = ba[gid];
+                const auto lo = amrex::lbound(bx);
+                const auto hi = amrex::ubound(bx);
 
-                if (norm == 0) {
-                    rerror[icomp_a] /= rerror_denom[icomp_a];
-                } else {
-                    const auto& dx = pf_a.cellSize(ilev);
-                    Real dv = 1.0;
-                    for (int idim = 0; idim < dm; ++idim) {
-                        dv *= dx[idim];
+                for (int icomp_a = 0; icomp_a < ncomp_a && !found_diff; ++icomp_a) {
+                    const int icomp_b = ivar_b[icomp_a];
+                    if (icomp_b < 0) { continue; }
+
+                    has_nan_a[icomp_a] = has_nan_a[icomp_a] || fab_a.contains_nan(fab_a.box(), icomp_a, 1);
+                    has_nan_b[icomp_a] = has_nan_b[icomp_a] || fab_b.contains_nan(fab_b.box(), icomp_b, 1);
+
+                    const auto a = fab_a.const_array(icomp_a);
+                    const auto b = fab_b.const_array(icomp_b);
+                    Array4<Real> diff;
+                    const bool save_diff = icomp_a == save_var_a;
+                    if (save_diff) {
+                        diff = mf_array[ilev].array(gid);
+                    }
+
+                    Real max_err = 0.0, sum_err = 0.0;
+                    Real max_a = 0.0, sum_a = 0.0;
+                    int nfail = 0;
+                    const Real abs_thresh = thresholds[icomp_a].first;
+                    const Real rel_thresh = thresholds[icomp_a].second;
+#ifdef AMREX_USE_OMP
+#pragma omp parallel for collapse(2) reduction(max:max_err,max_a) reduction(+:sum_err,sum_a,nfail)
+#endif
+                    for (int k = lo.z; k <= hi.z; ++k) {
+                    for (int j = lo.y; j <= hi.y; ++j) {
+                    for (int i = lo.x; i <= hi.x; ++i) {
+                        const Real d = std::abs(b(i,j,k) - a(i,j,k));
+                        const Real av = std::abs(a(i,j,k));
+                        max_err = std::max(max_err, d);
+                        max_a = std::max(max_a, av);
+                        if (norm == 2) {
+                            sum_err += d*d;
+                            sum_a += av*av;
+                        } else {
+                            sum_err += d;
+                            sum_a += av;
+                        }
+                        if (d > abs_thresh && d > rel_thresh) { ++nfail; }
+                        if (save_diff) { diff(i,j,k) = d; }
+                    }}}
+
+                    if (norm == 0) {
+                        aerror[icomp_a] = std::max(aerror[icomp_a], max_err);
+                        rerror_denom[icomp_a] = std::max(rerror_denom[icomp_a], max_a);
+                    } else {
+                        aerror[icomp_a] += sum_err;
+                        rerror_denom[icomp_a] += sum_a;
+                    }
+
+                    if (icomp_a == zone_info_var_a && max_err > zone_max_err) {
+                        zone_max_err = max_err;
+                        zone_gid = gid;
+                        zone_cell = bx.smallEnd();
+                        for (BoxIterator bit(bx); bit.ok(); ++bit) {
+                            const IntVect& iv = bit();
+                            if (std::abs(b(iv) - a(iv)) == max_err) {
+                                zone_cell = iv;
+                                break;
+                            }
+                        }
+                    }
+
+                    if (abort_on_first_diff && nfail > 0) {
+                        for (BoxIterator bit(bx); bit.ok(); ++bit) {
+                            const IntVect& iv = bit();
+                            const Real d = std::abs(b(iv) - a(iv));
+                            if (d > abs_thresh && d > rel_thresh) {
+                                diff_cell = iv;
+                                break;
+                            }
+                        }
+                        found_diff = true;
+                        diff_gid = gid;
+                        diff_comp = icomp_a;
+                        diff_a = a(diff_cell);
+                        diff_b = b(diff_cell);
                     }
-                    aerror[icomp_a] *= std::pow(dv,1./static_cast<Real>(norm));
-                    rerror[icomp_a] = rerror[icomp_a]/rerror_denom[icomp_a];
                 }
 
-                if (icomp_a == save_var_a || icomp_a == zone_info_var_a) {
-                    mf_b.abs(0,1);
+                if (found_diff) { break; }
+            }
+
+            if (abort_on_first_diff &&
+                report_first_diff(found_diff, ilev, diff_comp, diff_gid, diff_cell, diff_a, diff_b)) {
+                return EXIT_FAILURE;
+            }
+
+            ParallelDescriptor::ReduceIntMax(has_nan_a.data(), ncomp_a);
+            ParallelDescriptor::ReduceIntMax(has_nan_b.data(), ncomp_a);
+            if (norm == 0) {
+                ParallelDescriptor::ReduceRealMax(aerror.data(), ncomp_a);
+                ParallelDescriptor::ReduceRealMax(rerror_denom.data(), ncomp_a);
+            } else {
+                ParallelDescriptor::ReduceRealSum(aerror.data(), ncomp_a);
+                ParallelDescriptor::ReduceRealSum(rerror_denom.data(), ncomp_a);
+                if (norm == 2) {
+                    for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
+                        aerror[icomp_a] = std::sqrt(aerror[icomp_a]);
+                        rerror_denom[icomp_a] = std::sqrt(rerror_denom[icomp_a]);
+                    }
                 }
+            }
+            for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
+                rerror[icomp_a] = aerror[icomp_a];
+            }
 
-                if (icomp_a == save_var_a) {
-                    MultiFab::Copy(mf_array[ilev], mf_b, 0, 0, 1, 0);
+            if (zone_info_var_a >= 0) {
+                Real max_err = zone_max_err;
+                ParallelDescriptor::ReduceRealMax(max_err);
+                if (max_err > err_zone.max_abs_err) {
+                    int owner = (zone_gid >= 0 && zone_max_err == max_err)
+                        ? myproc : ParallelDescriptor::NProcs();
+                    ParallelDescriptor::ReduceIntMin(owner);
+                    ParallelDescriptor::Bcast(&zone_gid, 1, owner);
+                    ParallelDescriptor::Bcast(zone_cell.begin(), AMREX_SPACEDIM, owner);
+                    err_zone.max_abs_err = max_err;
+                    err_zone.level = ilev;
+                    err_zone.cell = zone_cell;
+                    err_zone.grid_index = zone_gid;
                 }
+            }
+        } else {
+            for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
+                if (ivar_b[icomp_a] >= 0) {
+                    const MultiFab& mf_a = pf_a.get(ilev, names_a[icomp_a]);
+                    MultiFab mf_b;
+                    if (grids_match) {
+                        mf_b = pf_b.get(ilev, names_b[ivar_b[icomp_a]]);
+                    } else {
+                        mf_b.define(mf_a.boxArray(), mf_a.DistributionMap(), 1, 0);
+                        MultiFab tmp = pf_b.get(ilev, names_b[ivar_b[icomp_a]]);
+                        mf_b.ParallelCopy(tmp);
+                    }
 
-                if (icomp_a == zone_info_var_a) {
-                    if (max_err > err_zone.max_abs_err) {
-                        err_zone.max_abs_err = max_err;
-                        err_zone.level = ilev;
-                        err_zone.cell = mf_b.maxIndex(0);
-                        auto isects = pf_a.boxArray(ilev).intersections
-                            (Box(err_zone.cell,err_zone.cell), true, 0);
-                        err_zone.grid_index = isects[0].first;
+                    if (abort_on_first_diff) {
+                        // The grids differ, so B was read whole and copied
+                        // to the grids of A; look for a difference here.
+                        const Real a_norm = (norm == 1) ? mf_a.norm1()
+                            : ((norm == 2) ? mf_a.norm2() : mf_a.norm0());
+                        const auto thresh = abort_thresholds(ilev, a_norm);
+                        bool found_diff = false;
+                        int diff_gid = -1;
+                        IntVect diff_cell;
+                        Real diff_a = 0.0, diff_b = 0.0;
+                        for (MFIter mfi(mf_a); mfi.isValid() && !found_diff; ++mfi) {
+                            const auto a = mf_a.const_array(mfi);
+                            const auto b = mf_b.const_array(mfi);
+                            for (BoxIterator bit(mfi.validbox()); bit.ok(); ++bit) {
+                                const IntVect& iv = bit();
+                                const Real d = std::abs(b(iv) - a(iv));
+                                if (d > thresh.first && d > thresh.second) {
+                                    found_diff = true;
+                                    diff_gid = mfi.index();
+                                    diff_cell = iv;
+                                    diff_a = a(iv);
+                                    diff_b = b(iv);
+                                    break;
+                                }
+                            }
+                        }
+                        if (report_first_diff(found_diff, ilev, icomp_a, diff_gid,
+                                              diff_cell, diff_a, diff_b)) {
+                            return EXIT_FAILURE;
+                        }
+                    }
+                    has_nan_a[icomp_a] = mf_a.contains_nan();
+                    has_nan_b[icomp_a] = mf_b.contains_nan();
+                    MultiFab::Subtract(mf_b,mf_a,0,0,1,0); // b = b - a
+                    Real max_err = mf_b.norm0();
+                    if (norm == 1) {
+                        aerror[icomp_a] = mf_b.norm1();
+                        rerror[icomp_a] = aerror[icomp_a];
+                        rerror_denom[icomp_a] = mf_a.norm1();
+                    } else if (norm == 2) {
+                        aerror[icomp_a] = mf_b.norm2();
+                        rerror[icomp_a] = aerror[icomp_a];
+                        rerror_denom[icomp_a] = mf_a.norm2();
+                    } else {
+                        aerror[icomp_a] = max_err;
+                        rerror[icomp_a] = aerror[icomp_a];
+                        rerror_denom[icomp_a] = mf_a.norm0();
                     }
+
+                    if (icomp_a == save_var_a || icomp_a == zone_info_var_a) {
+                        mf_b.abs(0,1);
+                    }
+
+                    if (icomp_a == save_var_a) {
+                        MultiFab::Copy(mf_array[ilev], mf_b, 0, 0, 1, 0);
+                    }
+
+                    if (icomp_a == zone_info_var_a) {
+                        if (max_err > err_zone.max_abs_err) {
+                            err_zone.max_abs_err = max_err;
+                            err_zone.level = ilev;
+                            err_zone.cell = mf_b.maxIndex(0);
+                            auto isects = pf_a.boxArray(ilev).intersections
+                                (Box(err_zone.cell,err_zone.cell), true, 0);
+                            err_zone.grid_index = isects[0].first;
+                        }
+                    }
+                }
+            }
+        }
+
+        for (int icomp_a = 0; icomp_a < ncomp_a; ++icomp_a) {
+            if (ivar_b[icomp_a] < 0) { continue; }
+            if (norm == 0) {
+                rerror[icomp_a] /= rerror_denom[icomp_a];
+            } else {
+                const auto& dx = pf_a.cellSize(ilev);
+                Real dv = 1.0;
+                for (int idim = 0; idim < dm; ++idim) {
+                    dv *= dx[idim];
                 }
+                aerror[icomp_a] *= std::pow(dv,1./static_cast<Real>(norm));
+                rerror[icomp_a] = rerror[icomp_a]/rerror_denom[icomp_a];
             }
         }
 
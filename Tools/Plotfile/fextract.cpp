@@ -217,62 +217,41 @@ void main_main()
 
         Array<Real,AMREX_SPACEDIM> dx = pf.cellSize(ilev);
 
+        IntVect ratio{1};
         if (ilev < fine_level) {
-            IntVect ratio{pf.refRatio(ilev)};
+            ratio = IntVect{pf.refRatio(ilev)};
             for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
                 ratio[idim] = 1;
             }
-            const iMultiFab mask = makeFineMask(pf.boxArray(ilev), pf.DistributionMap(ilev),
-                                                pf.boxArray(ilev+1), ratio);
-            for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                const MultiFab& mf = pf.get(ilev, var_names[ivar]);
-                for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-                    const Box& bx = mfi.validbox() & slice_box;
-                    if (bx.ok()) {
-                        const auto& m = mask.array(mfi);
-                        const auto& fab = mf.array(mfi);
-                        const auto lo = amrex::lbound(bx);
-                        const auto hi = amrex::ubound(bx);
-                        for         (int k = lo.z; k <= hi.z; ++k) {
-                            for     (int j = lo.y; j <= hi.y; ++j) {
-                                for (int i = lo.x; i <= hi.x; ++i) {
-                                    if (m(i,j,k) == 0) { // not covered by fine
-                                        if (pos.size() == data[ivar].size()) {
-                                            Array<Real,AMREX_SPACEDIM> p
-                                                = {AMREX_D_DECL(problo[0]+static_cast<Real>(i+0.5)*dx[0],
-                                                                problo[1]+static_cast<Real>(j+0.5)*dx[1],
-                                                                problo[2]+static_cast<Real>(k+0.5)*dx[2])};
-                                            pos.push_back(p[idir]);
-                                        }
-                                        data[ivar].push_back(fab(i,j,k));
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
+        }
+
+        // Only the FABs the slice passes through are read.
+        const MultiFab& mf = pf.get(ilev, slice_box, var_names);
+
+        if (!mf.boxArray().empty()) {
+            iMultiFab mask;
+            if (ilev < fine_level) {
+                mask = makeFineMask(mf.boxArray(), mf.DistributionMap(), pf.boxArray(ilev+1), ratio);
             }
-            rr *= ratio;
-        } else {
-            for (int ivar = 0; ivar < var_names.size(); ++ivar) {
-                const MultiFab& mf = pf.get(ilev, var_names[ivar]);
-                for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
-                    const Box& bx = mfi.validbox() & slice_box;
-                    if (bx.ok()) {
-                        const auto& fab = mf.array(mfi);
-                        const auto lo = amrex::lbound(bx);
-                        const auto hi = amrex::ubound(bx);
-                        for         (int k = lo.z; k <= hi.z; ++k) {
-                            for     (int j = lo.y; j <= hi.y; ++j) {
-                                for (int i = lo.x; i <= hi.x; ++i) {
-                                    if (pos.size() == data[ivar].size()) {
-                                        Array<Real,AMREX_SPACEDIM> p
-                                            = {AMREX_D_DECL(problo[0]+static_cast<Real>(i+0.5)*dx[0],
-                                                            problo[1]+static_cast<Real>(j+0.5)*dx[1],
-                                                            problo[2]+static_cast<Real>(k+0.5)*dx[2])};
-                                        pos.push_back(p[idir]);
+            for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+                const Box& bx = mfi.validbox() & slice_box;
+                if (bx.ok()) {
+                    const auto& m = (ilev < fine_level) ? mask.const_array(mfi) : Array4<int const>{};
+                    const auto& fab = mf.const_array(mfi);
+                    const auto lo = amrex::lbound(bx);
+                    const auto hi = amrex::ubound(bx);
+                    for         (int k = lo.z; k <= hi.z; ++k) {
+                        for     (int j = lo.y; j <= hi.y; ++j) {
+                            for (int i = lo.x; i <= hi.x; ++i) {
+                                if (ilev == fine_level || m(i,j,k) == 0) { // not covered by fine
+                                    Array<Real,AMREX_SPACEDIM> p
+                                        = {AMREX_D_DECL(problo[0]+static_cast<Real>(i+0.5)*dx[0],
+                                                        problo[1]+static_cast<Real>(j+0.5)*dx[1],
+                                                        problo[2]+static_cast<Real>(k+0.5)*dx[2])};
+                                    pos.push_back(p[idir]);
+                                    for (int ivar = 0; ivar < var_names.size(); ++ivar) {
+                                        data[ivar].push_back(fab(i,j,k,ivar));
                                     }
-                                    data[ivar].push_back(fab(i,j,k));
                                 }
                             }
                         }
@@ -280,6 +259,8 @@ void main_main()
                 }
             }
         }
+
+        rr *= ratio;
     }
 
 #ifdef BL_USE_MPI
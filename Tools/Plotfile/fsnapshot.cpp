@@ -80,6 +80,8 @@ void main_main()
             << "      [-p|--palette] pfname      : use the file pfname as the Palette (default ~/amrvis.Palette)\n"
             << "      -m val                     : set the minimum value of the data to val\n"
             << "      -M val                     : set the maximum value of the data to val\n"
+            << "                                   If both -m and -M are given, only the data on the\n"
+            << "                                   slices are read.\n"
             << "      [-L|--max_level] n         : max fine level to get data from (default: finest)\n"
             << "      [-l|--log]                 : toggle log plot\n"
             << "      [-n|--normaldir] {0,1,2,3} : direction normal to slice. (default: 3, i.e., all directions)\n"
@@ -198,70 +200,89 @@ void main_main()
     Real gmx = std::numeric_limits<Real>::lowest();
     Real gmn = std::numeric_limits<Real>::max();
 
+    // Unless both ends of the data range are given, the range is taken over
+    // the whole plotfile.  Otherwise, only the FABs the slices pass through
+    // are read.
+    const bool read_slices = ldef_mx && ldef_mn;
+
     for (int ilev = 0; ilev <= max_level; ++ilev) {
-        const MultiFab& pltmf = pf.get(ilev, compname);
-        gmx = std::max(gmx, pltmf.max(0));
-        gmn = std::min(gmn, pltmf.min(0));
-        if (ilev < max_level) {
-            IntVect ratio{pf.refRatio(ilev)};
-            for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
-                ratio[idim] = 1;
+        IntVect rrlev {rr[ilev]};
+        for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
+            rrlev[idim] = 1;
+        }
+        const int nreads = read_slices ? ndir_end-ndir_begin : 1;
+        for (int iread = 0; iread < nreads; ++iread) {
+            const int dir_begin = read_slices ? ndir_begin+iread : ndir_begin;
+            const int dir_end = read_slices ? dir_begin+1 : ndir_end;
+            const MultiFab& pltmf = read_slices
+                ? pf.get(ilev, amrex::coarsen(finebox[dir_begin], rrlev), Vector<std::string>{compname})
+                : pf.get(ilev, compname);
+            if (!read_slices) {
+                gmx = std::max(gmx, pltmf.max(0));
+                gmn = std::min(gmn, pltmf.min(0));
             }
-            const iMultiFab mask = makeFineMask(pltmf, pf.boxArray(ilev+1), ratio);
-            for (MFIter mfi(pltmf); mfi.isValid(); ++mfi) {
-                const auto& m = mask.array(mfi);
-                const auto& plt = pltmf.array(mfi);
-                const Box& bx = mfi.validbox();
-                IntVect rrlev {rr[ilev]};
+            if (pltmf.boxArray().empty()) {
+                continue;
+            }
+            if (ilev < max_level) {
+                IntVect ratio{pf.refRatio(ilev)};
                 for (int idim = dim; idim < AMREX_SPACEDIM; ++idim) {
-                    rrlev[idim] = 1;
+                    ratio[idim] = 1;
                 }
-                for (int idir = ndir_begin; idir < ndir_end; ++idir) {
-                    const Box& crsebox = amrex::coarsen(finebox[idir], rrlev);
-                    const Box& ibox = bx & crsebox;
-                    if (ibox.ok()) {
-                        const auto& data = datamf[idir].array(0); // there is only one box
-                        IntVect rrslice = rrlev;
-                        rrslice[idir] = 1;
-                        amrex::For(ibox, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                        {
-                            if (m(i,j,k) == 0) { // not covered by fine
-                                const Real d = plt(i,j,k);
-                                for         (int koff = 0; koff < rrslice[2]; ++koff) {
-                                    int kk = k*rrlev[2] + koff;
-                                    for     (int joff = 0; joff < rrslice[1]; ++joff) {
-                                        int jj = j*rrlev[1] + joff;
-                                        for (int ioff = 0; ioff < rrslice[0]; ++ioff) {
-                                            int ii = i*rrlev[0] + ioff;
-                                            data(ii,jj,kk) = d;
+                const iMultiFab mask = makeFineMask(pltmf, pf.boxArray(ilev+1), ratio);
+                for (MFIter mfi(pltmf); mfi.isValid(); ++mfi) {
+                    const auto& m = mask.array(mfi);
+                    const auto& plt = pltmf.array(mfi);
+                    const Box& bx = mfi.validbox();
+                    for (int idir = dir_begin; idir < dir_end; ++idir) {
+                        const Box& crsebox = amrex::coarsen(finebox[idir], rrlev);
+                        const Box& ibox = bx & crsebox;
+                        if (ibox.ok()) {
+                            const auto& data = datamf[idir].array(0); // there is only one box
+                            IntVect rrslice = rrlev;
+                            rrslice[idir] = 1;
+                            amrex::For(ibox, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                            {
+                                if (m(i,j,k) == 0) { // not covered by fine
+                                    const Real d = plt(i,j,k);
+                                    for         (int koff = 0; koff < rrslice[2]; ++koff) {
+                                        int kk = k*rrlev[2] + koff;
+                                        for     (int joff = 0; joff < rrslice[1]; ++joff) {
+                                            int jj = j*rrlev[1] + joff;
+                                            for (int ioff = 0; ioff < rrslice[0]; ++ioff) {
+                                                int ii = i*rrlev[0] + ioff;
+                                                data(ii,jj,kk) = d;
+                                            }
                                         }
                                     }
                                 }
-                            }
-                        });
+                            });
+                        }
                     }
                 }
-            }
-        } else {
-            for (MFIter mfi(pltmf); mfi.isValid(); ++mfi) {
-                const auto& plt = pltmf.array(mfi);
-                const Box& bx = mfi.validbox();
-                for (int idir = ndir_begin; idir < ndir_end; ++idir) {
-                    const Box& ibox = bx & finebox[idir];
-                    if (ibox.ok()) {
-                        const auto& data = datamf[idir].array(0); // there is only one box
-                        amrex::ParallelFor(ibox, [=] AMREX_GPU_DEVICE (int i, int j, int k)
-                        {
-                            data(i,j,k) = plt(i,j,k);
-                        });
+            } else {
+                for (MFIter mfi(pltmf); mfi.isValid(); ++mfi) {
+                    const auto& plt = pltmf.array(mfi);
+                    const Box& bx = mfi.validbox();
+                    for (int idir = dir_begin; idir < dir_end; ++idir) {
+                        const Box& ibox = bx & finebox[idir];
+                        if (ibox.ok()) {
+                            const auto& data = datamf[idir].array(0); // there is only one box
+                            amrex::ParallelFor(ibox, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+                            {
+                                data(i,j,k) = plt(i,j,k);
+                            });
+                        }
                     }
                 }
             }
         }
     }
 
-    amrex::Print() << " plotfile variable maximum = " << gmx << "\n"
-                   << " plotfile variable minimum = " << gmn << "\n";
+    if (!read_slices) {
+        amrex::Print() << " plotfile variable maximum = " << gmx << "\n"
+                       << " plotfile variable minimum = " << gmn << "\n";
+    }
 
     if (ldef_mx) {
         amrex::Print() << " resetting variable maximum to " << def_mx << "\n";